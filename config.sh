@@ -2,4 +2,6 @@
 export RISCV_BIN_PATH="/Users/PJ/Downloads/xpack-riscv-none-elf-gcc-15.2.0-1/bin"
 export CC="$RISCV_BIN_PATH/riscv-none-elf-gcc"
 export OBJCOPY="$RISCV_BIN_PATH/riscv-none-elf-objcopy"
-export CFLAGS="-march=rv32i -mabi=ilp32 -nostdlib -ffreestanding -O1"
\ No newline at end of file
+# MARCH=rv32iac_zba_zbb builds compressed (RVC) firmware; keep the default with ICACHE_ENABLE=1
+export MARCH="${MARCH:-rv32ia_zba_zbb}"
+export CFLAGS="-march=$MARCH -mabi=ilp32 -nostdlib -ffreestanding -O1"
\ No newline at end of file
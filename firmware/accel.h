@@ -0,0 +1,27 @@
+#ifndef ACCEL_H
+#define ACCEL_H
+
+#include <stdint.h>
+
+// --- CUSTOM-INSTRUCTION ACCELERATOR (accel_crc32.sv) ---
+// custom-0 (opcode 0x0B), funct7 = 0. Emitted with .insn so no toolchain
+// support is needed. soc_top builds with ACCEL_ENABLE=0 return 0 instead.
+#define ACCEL_CUSTOM0      0x0B
+#define ACCEL_CRC32_B      0   // funct3: one byte (rs2[7:0])
+#define ACCEL_CRC32_W      2   // funct3: one little-endian word
+
+// Helper: One CRC-32 step over the low byte of 'data' (no pre/post inversion)
+static inline uint32_t crc32_step_byte(uint32_t crc, uint32_t data) {
+    uint32_t result;
+    __asm__ volatile (".insn r 0x0B, 0, 0, %0, %1, %2" : "=r"(result) : "r"(crc), "r"(data));
+    return result;
+}
+
+// Helper: One CRC-32 step over a whole word, equal to four byte steps
+static inline uint32_t crc32_step_word(uint32_t crc, uint32_t data) {
+    uint32_t result;
+    __asm__ volatile (".insn r 0x0B, 2, 0, %0, %1, %2" : "=r"(result) : "r"(crc), "r"(data));
+    return result;
+}
+
+#endif
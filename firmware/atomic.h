@@ -0,0 +1,79 @@
+#ifndef ATOMIC_H
+#define ATOMIC_H
+
+#include <stdint.h>
+
+// --- RV32A PRIMITIVES ---
+// Each AMO is a single bus read-modify-write, so a timer trap cannot split it.
+// An LR/SC pair is retried if a trap or a DMA write lands in between
+// (both invalidate the reservation in bus_interconnect.sv).
+
+// Helper: *p += v, returns the old value
+static inline uint32_t atomic_fetch_add(volatile uint32_t* p, uint32_t v) {
+    uint32_t old;
+    __asm__ volatile ("amoadd.w %0, %2, (%1)" : "=r"(old) : "r"(p), "r"(v) : "memory");
+    return old;
+}
+
+// Helper: *p = v, returns the old value
+static inline uint32_t atomic_swap(volatile uint32_t* p, uint32_t v) {
+    uint32_t old;
+    __asm__ volatile ("amoswap.w %0, %2, (%1)" : "=r"(old) : "r"(p), "r"(v) : "memory");
+    return old;
+}
+
+// Helper: *p |= mask / *p &= mask, returns the old value (bitmap updates)
+static inline uint32_t atomic_fetch_or(volatile uint32_t* p, uint32_t mask) {
+    uint32_t old;
+    __asm__ volatile ("amoor.w %0, %2, (%1)" : "=r"(old) : "r"(p), "r"(mask) : "memory");
+    return old;
+}
+
+static inline uint32_t atomic_fetch_and(volatile uint32_t* p, uint32_t mask) {
+    uint32_t old;
+    __asm__ volatile ("amoand.w %0, %2, (%1)" : "=r"(old) : "r"(p), "r"(mask) : "memory");
+    return old;
+}
+
+// Helper: if (*p == expected) *p = desired. Returns 1 on success.
+static inline int atomic_compare_swap(volatile uint32_t* p, uint32_t expected, uint32_t desired) {
+    uint32_t old, failed;
+    do {
+        __asm__ volatile ("lr.w %0, (%1)" : "=r"(old) : "r"(p) : "memory");
+        if (old != expected) return 0;
+        __asm__ volatile ("sc.w %0, %2, (%1)" : "=r"(failed) : "r"(p), "r"(desired) : "memory");
+    } while (failed);
+    return 1;
+}
+
+// --- SINGLE-PRODUCER / SINGLE-CONSUMER QUEUE ---
+// One side may be an ISR and the other a task. Each index is written by
+// only one side, so publishing the slot before the index is enough; the
+// AMO on the index orders it after the slot store on this in-order core.
+#define SPSC_CAPACITY 16 // Slots, power of two
+
+typedef struct {
+    volatile uint32_t head;                 // Next slot to write (producer)
+    volatile uint32_t tail;                 // Next slot to read (consumer)
+    volatile uint32_t slots[SPSC_CAPACITY];
+} spsc_queue_t;
+
+// Helper: Returns 0 if the queue is full
+static inline int spsc_push(spsc_queue_t* q, uint32_t value) {
+    uint32_t head = q->head;
+    if (head - q->tail == SPSC_CAPACITY) return 0;
+    q->slots[head & (SPSC_CAPACITY - 1)] = value;
+    atomic_fetch_add(&q->head, 1);
+    return 1;
+}
+
+// Helper: Returns 0 if the queue is empty
+static inline int spsc_pop(spsc_queue_t* q, uint32_t* value) {
+    uint32_t tail = q->tail;
+    if (q->head == tail) return 0;
+    *value = q->slots[tail & (SPSC_CAPACITY - 1)];
+    atomic_fetch_add(&q->tail, 1);
+    return 1;
+}
+
+#endif
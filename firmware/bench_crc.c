@@ -0,0 +1,69 @@
+#include <stdint.h>
+#include "print.h"
+#include "host.h"
+#include "accel.h"
+
+// --- CRC-32 ACCELERATOR BENCHMARK ---
+// The same buffer is checksummed by the bitwise software loop and by the
+// custom-0 crc32.w instruction. Both must match the CRC computed offline
+// (zlib.crc32 of the same 512 bytes), so a miscompiled or misdecoded
+// reference fails the run as well; compare cycles, and rerun with the
+// single-cycle unit or none:
+//   APP=bench_crc CONSOLE=host ./run.sh soc_top
+//   APP=bench_crc CONSOLE=host VERILATOR_FLAGS=-GCRC_BITS_PER_CYCLE=32 ./run.sh soc_top
+
+// Buffer at a fixed address, clear of the kernel map and trace ring
+#define BENCH_BUFFER      ((volatile uint32_t *)0x20000400)
+#define BENCH_WORDS       128   // 512 bytes
+#define BENCH_EXPECTED    0x4BD6727A  // CRC-32 of the xorshift32 buffer below
+
+// Reference: reflected CRC-32, one bit per iteration
+static uint32_t crc32_software(volatile uint32_t* buffer, uint32_t words) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint32_t i = 0; i < words; i++) {
+        crc ^= buffer[i];
+        for (int bit = 0; bit < 32; bit++) crc = (crc >> 1) ^ (0xEDB88320 & (0u - (crc & 1)));
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+static uint32_t crc32_accel(volatile uint32_t* buffer, uint32_t words) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint32_t i = 0; i < words; i++) crc = crc32_step_word(crc, buffer[i]);
+    return crc ^ 0xFFFFFFFF;
+}
+
+int main() {
+    // Deterministic, non-trivial contents (xorshift32: no multiply on rv32i)
+    uint32_t seed = 0x12345678;
+    for (uint32_t i = 0; i < BENCH_WORDS; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        BENCH_BUFFER[i] = seed;
+    }
+
+    print_str("[BENCH] CRC-32 over 512 bytes\n");
+
+    uint32_t start = host_cycles();
+    uint32_t softwareCrc = crc32_software(BENCH_BUFFER, BENCH_WORDS);
+    uint32_t softwareCycles = host_cycles() - start;
+
+    start = host_cycles();
+    uint32_t accelCrc = crc32_accel(BENCH_BUFFER, BENCH_WORDS);
+    uint32_t accelCycles = host_cycles() - start;
+
+    print_str("[BENCH] software crc ");
+    print_hex(softwareCrc);
+    print_str("cycles ");
+    print_hex(softwareCycles);
+    print_str("\n[BENCH] crc32.w  crc ");
+    print_hex(accelCrc);
+    print_str("cycles ");
+    print_hex(accelCycles);
+    print_str("\n");
+
+    // Exit status bit 0: software mismatch, bit 1: accelerator mismatch (always set with ACCEL_ENABLE=0)
+    host_exit((softwareCrc != BENCH_EXPECTED) | ((accelCrc != BENCH_EXPECTED) << 1));
+    return 0;
+}
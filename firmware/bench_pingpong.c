@@ -0,0 +1,120 @@
+#include <stdint.h>
+#include "print.h"
+#include "host.h"
+#include "kernel.h"
+
+// --- PING-PONG ROUND-TRIP BENCHMARK ---
+// Two tasks bounce one 64-byte pool buffer through a pair of pointer queues, then
+// bounce a token through a pair of semaphores. Each round trip is two
+// blocking hand-offs (two context switches); the payload is never copied.
+// Last, both tasks increment a shared counter under a mutex, yielding
+// inside the critical section so every lock is contended.
+// Every phase checks its ordering, and the run exits non-zero on any error,
+// so the printed cycles only count once the exit status is 0.
+//   APP=bench_pingpong CONSOLE=host ./run.sh soc_top
+
+#define ROUNDS         32
+#define ROUNDS_SHIFT   5      // Average without a divide
+
+typedef struct {
+    uint32_t sequence;
+    uint32_t payload[15];
+} message_t;                 // One object pool block
+
+static int       pingId, pongId;
+static void*     toPongSlots[1];
+static void*     toPingSlots[1];
+static queue_t   toPong, toPing;
+static sem_t     semPing, semPong;
+static mutex_t   lock;
+static volatile uint32_t errors;
+static volatile uint32_t pongRounds;   // Semaphore rounds pong has completed
+static volatile uint32_t shared;       // Incremented under 'lock' by both tasks
+
+// One contended increment: the yield inside the critical section lets the
+// other task run into the held lock
+static void locked_increment(void) {
+    if (mutex_lock(&lock) != 0) errors++;
+    uint32_t value = shared;
+    task_yield();
+    shared = value + 1;
+    if (mutex_unlock(&lock) != 0) errors++;
+}
+
+static void report(const char* name, uint32_t cycles) {
+    print_str(name);
+    print_str(" total ");
+    print_hex(cycles);
+    print_str("per round trip ");
+    print_hex(cycles >> ROUNDS_SHIFT);
+    print_str("\n");
+}
+
+static void pong(void* arg) {
+    (void)arg;
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        message_t* message = queue_receive(&toPong);
+        message->sequence++;
+        queue_send(&toPing, message);
+    }
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        sem_take(&semPong);
+        pongRounds = i + 1;
+        sem_give(&semPing);
+    }
+    for (uint32_t i = 0; i < ROUNDS; i++) locked_increment();
+    sem_give(&semPing);
+}
+
+static void ping(void* arg) {
+    (void)arg;
+    print_str("[BENCH] Ping-pong, 32 round trips\n");
+
+    message_t* buffer = kernel_alloc();
+    if (!buffer) host_exit(1);
+    buffer->sequence = 0;
+
+    uint32_t start = host_cycles();
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        queue_send(&toPong, buffer);
+        message_t* message = queue_receive(&toPing);
+        if (message != buffer || message->sequence != i + 1) errors++;
+    }
+    report("[BENCH] queue    ", host_cycles() - start);
+    kernel_free(buffer);
+
+    start = host_cycles();
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        sem_give(&semPong);
+        sem_take(&semPing);
+        if (pongRounds != i + 1) errors++;
+    }
+    report("[BENCH] semaphore", host_cycles() - start);
+
+    // Both tasks take the lock ROUNDS times; pong signals when it is done
+    start = host_cycles();
+    for (uint32_t i = 0; i < ROUNDS; i++) locked_increment();
+    sem_take(&semPing);
+    report("[BENCH] mutex    ", host_cycles() - start);
+    if (shared != 2 * ROUNDS) errors++;
+
+    print_str("[BENCH] stack words never used: ping ");
+    print_hex(task_stack_unused(pingId));
+    print_str("pong ");
+    print_hex(task_stack_unused(pongId));
+    print_str("\n");
+
+    host_exit(errors);
+}
+
+int main() {
+    queue_init(&toPong, toPongSlots, 1);
+    queue_init(&toPing, toPingSlots, 1);
+    sem_init(&semPing, 0);
+    sem_init(&semPong, 0);
+    mutex_init(&lock);
+    pingId = task_create(ping, 0);
+    pongId = task_create(pong, 0);
+    kernel_start();
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <stdint.h>
+#include "print.h"
+#include "host.h"
+#include "atomic.h"
+#include "smp.h"
+
+// --- SMP SCALING BENCHMARK ---
+// A fixed pool of independent work items is drained by every hart through a
+// shared atomic counter. Each item also bumps a second counter through an
+// LR/SC compare-and-swap loop. The checksum, the item count and the CAS
+// count are checked at the end; the run exits non-zero if any is off.
+// Run once per soc_top build and compare cycles:
+//   APP=bench_smp CONSOLE=host ./run.sh soc_top
+//   APP=bench_smp CONSOLE=host VERILATOR_FLAGS="-GHARTS=2 -GRAM_WORDS=2048" ./run.sh soc_top
+// (a second boot stack does not fit beside the pools in the default 4KB RAM)
+
+// Shared state (fixed addresses, clear of the kernel map and trace ring)
+#define BENCH_BASE        0x20000400
+#define BENCH_START       (*(volatile uint32_t *)(BENCH_BASE + 0x00)) // Released by hart 0
+#define BENCH_NEXT_ITEM   (*(volatile uint32_t *)(BENCH_BASE + 0x04))
+#define BENCH_DONE_HARTS  (*(volatile uint32_t *)(BENCH_BASE + 0x08))
+#define BENCH_CHECKSUM    (*(volatile uint32_t *)(BENCH_BASE + 0x0C))
+#define BENCH_ITEMS_DONE  ((volatile uint32_t *)(BENCH_BASE + 0x10))  // Per hart
+#define BENCH_CAS_COUNT   (*(volatile uint32_t *)(BENCH_BASE + 0x40)) // One CAS increment per item
+
+#define BENCH_ITEMS       64
+#define BENCH_ROUNDS      200   // Mixing rounds per item (compute-bound, no bus traffic)
+#define BENCH_EXPECTED    0x60D10E47  // Sum of bench_item() over all items, computed offline
+
+// One work item: a rotate/xor mix, kept in registers
+static uint32_t bench_item(uint32_t item) {
+    uint32_t x = item ^ 0x9E3779B9;
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        x = ((x << 5) | (x >> 27)) ^ (x + round);
+    }
+    return x;
+}
+
+// Claims items until the pool is empty, then reports in
+static void bench_worker(uint32_t hart) {
+    uint32_t sum = 0, items = 0;
+    while (1) {
+        uint32_t item = atomic_fetch_add(&BENCH_NEXT_ITEM, 1);
+        if (item >= BENCH_ITEMS) break;
+        sum += bench_item(item);
+        items++;
+        uint32_t count;
+        do {
+            count = BENCH_CAS_COUNT;
+        } while (!atomic_compare_swap(&BENCH_CAS_COUNT, count, count + 1));
+    }
+    atomic_fetch_add(&BENCH_CHECKSUM, sum);
+    BENCH_ITEMS_DONE[hart] = items;
+    atomic_fetch_add(&BENCH_DONE_HARTS, 1);
+}
+
+// Entry for harts other than 0 (crt0.s)
+void hart_main(uint32_t hart) {
+    while (BENCH_START == 0);
+    bench_worker(hart);
+    while (1);
+}
+
+int main() {
+    uint32_t harts = num_harts();
+
+    BENCH_NEXT_ITEM  = 0;
+    BENCH_DONE_HARTS = 0;
+    BENCH_CHECKSUM   = 0;
+    BENCH_CAS_COUNT  = 0;
+
+    print_str("[BENCH] SMP work pool, harts = ");
+    print_hex(harts);
+    print_str("\n");
+
+    uint32_t start = host_cycles();
+    BENCH_START = 1;
+    bench_worker(0);
+    while (BENCH_DONE_HARTS != harts);
+    uint32_t elapsed = host_cycles() - start;
+
+    for (uint32_t hart = 0; hart < harts; hart++) {
+        print_str("[BENCH] hart ");
+        print_hex(hart);
+        print_str(" items ");
+        print_hex(BENCH_ITEMS_DONE[hart]);
+        print_str("\n");
+    }
+    print_str("[BENCH] checksum ");
+    print_hex(BENCH_CHECKSUM);
+    print_str("\n[BENCH] cycles ");
+    print_hex(elapsed);
+    print_str("\n");
+
+    uint32_t items = 0;
+    for (uint32_t hart = 0; hart < harts; hart++) items += BENCH_ITEMS_DONE[hart];
+    host_exit((BENCH_CHECKSUM != BENCH_EXPECTED) | ((items != BENCH_ITEMS) << 1) |
+              ((BENCH_CAS_COUNT != BENCH_ITEMS) << 2));
+    return 0;
+}
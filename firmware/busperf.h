@@ -0,0 +1,34 @@
+#ifndef BUSPERF_H
+#define BUSPERF_H
+
+#include <stdint.h>
+
+// Bus Performance Counters (bus_interconnect.sv, section 6)
+// Transactions are counted per access; the byte counters add the byte lanes
+// each access uses, so LB/LH/SB/SH count 1 or 2 bytes rather than 4.
+#define BUSPERF_BASE     0x40000200
+#define BUSPERF_CLEAR    (*(volatile uint32_t *)BUSPERF_BASE)
+#define BUSPERF(index)   (*(volatile uint32_t *)(BUSPERF_BASE + 4 * (index)))
+
+#define BUSPERF_CPU_READS   0
+#define BUSPERF_CPU_WRITES  1
+#define BUSPERF_CPU_STALLS  2
+#define BUSPERF_DMA_READS   3
+#define BUSPERF_DMA_WRITES  4
+#define BUSPERF_DMA_STALLS  5
+#define BUSPERF_ROM_READS   6
+#define BUSPERF_RAM_READS   7
+#define BUSPERF_RAM_WRITES  8
+#define BUSPERF_IO_READS    9
+#define BUSPERF_IO_WRITES   10
+#define BUSPERF_BUSY_CYCLES 11
+#define BUSPERF_CYCLES      12
+#define BUSPERF_HART_STALLS 13  // Cycles a hart waited on another hart (HARTS > 1)
+#define BUSPERF_READ_BYTES  14
+#define BUSPERF_WRITE_BYTES 15
+
+static inline void busperf_clear(void) {
+    BUSPERF_CLEAR = 0;
+}
+
+#endif
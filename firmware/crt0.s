@@ -1,6 +1,46 @@
 .section .text
 .global _start
 
+# ==============================================================================
+# KERNEL EVENT TRACE (layout shared with trace.h)
+# ==============================================================================
+.equ TRACE_BASE,        0x20000100
+.equ TRACE_CAPACITY,    32
+.equ TRACE_CYCLES,      0x40000108
+.equ CURRENT_TASK_PTR,  0x20000010
+.equ TRACE_IRQ_ENTER,   1
+.equ TRACE_IRQ_EXIT,    2
+
+# Trap state and interrupt controller (layout shared with irq.h)
+.equ CSR_MEPC,          0x40000010
+.equ CSR_MSTATUS,       0x40000020
+.equ MSTATUS_MIE,       0x8
+.equ IRQ_CLAIM,         0x4000040C
+.equ IRQ_SOURCES,       4
+
+# Hart boot (layout shared with smp.h)
+.equ SMP_MHARTID,       0x40000014
+
+# Append {cycle, type|task} to the trace ring. Clobbers t0-t2, so it may only
+# be used while those registers are saved in the trap frame.
+.macro TRACE_EVENT type
+    li   t0, TRACE_BASE
+    li   t2, 1
+    amoadd.w t1, t2, (t0)           # t1 = events written so far (claimed atomically)
+    andi t1, t1, TRACE_CAPACITY-1
+    slli t1, t1, 3                  # 8 bytes per entry
+    add  t1, t1, t0
+    li   t2, TRACE_CYCLES
+    lw   t2, 0(t2)
+    sw   t2, 8(t1)                  # word 0: timestamp
+    li   t0, CURRENT_TASK_PTR
+    lw   t0, 0(t0)
+    slli t0, t0, 16
+    li   t2, (\type << 24)
+    or   t2, t2, t0
+    sw   t2, 12(t1)                 # word 1: type | task
+.endm
+
 # ==============================================================================
 # 0x00000000: RESET VECTOR
 # ==============================================================================
@@ -10,10 +50,13 @@ _start:
 # ==============================================================================
 # 0x00000010: TRAP VECTOR (Hardware Interrupt Entry)
 # ==============================================================================
+# Every interrupt enters here: directly (MTVEC reset value 0x10) or through
+# irq_vectors below. The frame also holds MEPC and MSTATUS, so a higher-
+# priority source may preempt the handler once MIE is set again.
 .org 0x10                   # Force physical alignment for hardware vectoring
 trap_vector:
     # 1. ALLOCATE STACK FRAME
-    # Reserving 128 bytes (32 registers * 4 bytes)
+    # Reserving 128 bytes (30 registers, MEPC, MSTATUS)
     addi sp, sp, -128
     
     # 2. SAVE CPU CONTEXT
@@ -49,16 +92,46 @@ trap_vector:
     sw gp,  112(sp)
     sw tp,  116(sp)
 
-    # 3. EXECUTE SCHEDULER
-    # Pass current Stack Pointer (SP) as first argument to scheduler()
-    mv a0, sp
-    call scheduler
-    
-    # scheduler() returns the new Task's SP in a0
+    # 3. SAVE TRAP STATE & READ THE CLAIMED SOURCE
+    # The controller claimed the source as the trap was taken; s0 keeps its
+    # ID (s0 is already in the frame) until it is completed below.
+    li t0, CSR_MEPC
+    lw t1, 0(t0)
+    sw t1,  120(sp)
+    li t0, CSR_MSTATUS
+    lw t1, 0(t0)
+    sw t1,  124(sp)
+    li t0, IRQ_CLAIM
+    lw s0, 0(t0)
+
+    TRACE_EVENT TRACE_IRQ_ENTER
+
+    # 4. DISPATCH (NESTABLE)
+    # MIE on: only sources above this one's priority can interrupt here.
+    # irq_dispatch(id, sp) returns the SP to resume, another task's after a
+    # scheduler tick.
+    li t0, CSR_MSTATUS
+    li t1, MSTATUS_MIE
+    sw t1, 0(t0)
+    mv a0, s0
+    mv a1, sp
+    call irq_dispatch
     mv sp, a0
+    li t0, CSR_MSTATUS
+    sw zero, 0(t0)
+    li t0, IRQ_CLAIM
+    sw s0, 0(t0)            # Complete: lowers the controller's priority ceiling
+
+    TRACE_EVENT TRACE_IRQ_EXIT
 
-    # 4. RESTORE CPU CONTEXT
-    # Loading state from the new task's stack frame
+    # 5. RESTORE TRAP STATE & CPU CONTEXT
+    # Loading state from the (possibly new) task's stack frame
+    li t0, CSR_MEPC
+    lw t1,  120(sp)
+    sw t1, 0(t0)
+    li t0, CSR_MSTATUS
+    lw t1,  124(sp)
+    sw t1, 0(t0)
     lw ra,  0(sp)
     lw t0,  4(sp)
     lw t1,  8(sp)
@@ -90,20 +163,89 @@ trap_vector:
     lw gp,  112(sp)
     lw tp,  116(sp)
 
-    # 5. RELEASE STACK FRAME & EXIT
+    # 6. RELEASE STACK FRAME & EXIT
     addi sp, sp, 128
     mret                    # Return to PC saved in MEPC register
 
+# ==============================================================================
+# VECTOR TABLE (MTVEC = irq_vectors | 1)
+# ==============================================================================
+# Vectored mode enters at base + 4 * ID. This default table funnels every ID
+# into trap_vector; a program with a dedicated entry for a source builds its
+# own table the same way. Entries must stay 4 bytes, so they are never
+# compressed.
+.global irq_vectors
+.balign 4
+.option push
+.option norvc
+irq_vectors:
+    .rept IRQ_SOURCES + 1
+    j trap_vector
+    .endr
+.option pop
+
 # ==============================================================================
 # INITIALIZATION (CRT_INIT)
 # ==============================================================================
 crt_init:
-    # Initialize Stack Pointer to top of 4KB RAM (0x20000000 + 0x1000)
-    li sp, 0x20001000
-    
+    # Global pointer for linker-relaxed accesses to small data (norelax, or
+    # the assembler would relax this 'la' against gp itself)
+    .option push
+    .option norelax
+    la   gp, __global_pointer$
+    .option pop
+
+    # Each hart gets its own stack: hart N's top is _stack_top - N * SMP_STACK_SIZE
+    # (hart 0 keeps the top of RAM; link.ld sizes it from RAM_WORDS). Harts
+    # beyond the HARTS the firmware was linked for have no stack and park.
+    li   t0, SMP_MHARTID
+    lw   a0, 0(t0)
+    la   t1, HARTS
+    bgeu a0, t1, _exit_hang
+    la   sp, _stack_top
+    la   t1, SMP_STACK_SIZE     # Absolute linker symbol: its address is the size
+1:  beqz a0, 2f
+    sub  sp, sp, t1
+    addi a0, a0, -1
+    j    1b
+2:  lw   a0, 0(t0)
+    beqz a0, boot_init
+
+    # Harts other than 0 enter hart_main(hart_id); by default they park
+    call hart_main
+    j _exit_hang
+
+boot_init:
+    # Copy .data from its ROM image and zero .bss (hart 0 only)
+    lui  t0, %hi(_data_start)
+    addi t0, t0, %lo(_data_start)
+    lui  t1, %hi(_data_end)
+    addi t1, t1, %lo(_data_end)
+    lui  t2, %hi(_data_load_start)
+    addi t2, t2, %lo(_data_load_start)
+3:  beq  t0, t1, 4f
+    lw   t3, 0(t2)
+    sw   t3, 0(t0)
+    addi t0, t0, 4
+    addi t2, t2, 4
+    j    3b
+4:  lui  t0, %hi(_bss_start)
+    addi t0, t0, %lo(_bss_start)
+    lui  t1, %hi(_bss_end)
+    addi t1, t1, %lo(_bss_end)
+5:  beq  t0, t1, boot_main
+    sw   zero, 0(t0)
+    addi t0, t0, 4
+    j    5b
+
+boot_main:
     # Transfer control to main C application
     call main
     
     # Hang if main ever returns
 _exit_hang:
-    j _exit_hang
\ No newline at end of file
+    j _exit_hang
+
+.weak hart_main
+hart_main:
+    j hart_main
\ No newline at end of file
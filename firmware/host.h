@@ -0,0 +1,44 @@
+#ifndef HOST_H
+#define HOST_H
+
+#include <stdint.h>
+
+// Host Region (serviced by the simulation harness, see sim/host_channel.h)
+#define HOST_PUTS      (*(volatile uint32_t *)0x40000100)
+#define HOST_EXIT      (*(volatile uint32_t *)0x40000104)
+#define HOST_CYCLE_LO  (*(volatile uint32_t *)0x40000108)
+#define HOST_CYCLE_HI  (*(volatile uint32_t *)0x4000010C)
+#define HOST_PUTC      (*(volatile uint32_t *)0x40000110)
+
+// Helper: Print a whole string in one bus write (harness reads it from memory)
+static inline void host_puts(const char* s) {
+    HOST_PUTS = (uint32_t)s;
+}
+
+// Helper: Print one character with no UART timing
+static inline void host_putc(char c) {
+    HOST_PUTC = c;
+}
+
+// Helper: End the simulation and report a status code (0 = pass)
+static inline void host_exit(uint32_t status) {
+    HOST_EXIT = status;
+    while (1);
+}
+
+// Helper: Fail the run if 'condition' is false. The harness reports the
+// line (exit status HOST_ASSERT_FAILED | line) and dumps its flight recorder.
+#define HOST_ASSERT_FAILED 0xA5A50000
+#define host_assert(condition) do {                                              \
+        if (!(condition)) {                                                      \
+            host_puts("\n[ASSERT] " __FILE__ ": " #condition "\n");             \
+            host_exit(HOST_ASSERT_FAILED | (__LINE__ & 0xFFFF));                 \
+        }                                                                        \
+    } while (0)
+
+// Helper: Low 32 bits of the hardware cycle counter
+static inline uint32_t host_cycles(void) {
+    return HOST_CYCLE_LO;
+}
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef IRQ_H
+#define IRQ_H
+
+#include <stdint.h>
+
+// --- INTERRUPT CONTROLLER (irq_controller.sv, one per hart) ---
+// Every hart sees its own controller at the same addresses.
+#define IRQ_BASE         0x40000400
+#define IRQ_PENDING      (*(volatile uint32_t *)(IRQ_BASE + 0x00)) // W: 1s raise sources
+#define IRQ_ENABLE       (*(volatile uint32_t *)(IRQ_BASE + 0x04))
+#define IRQ_THRESHOLD    (*(volatile uint32_t *)(IRQ_BASE + 0x08))
+#define IRQ_CLAIM        (*(volatile uint32_t *)(IRQ_BASE + 0x0C)) // R: claimed ID, W: complete
+#define IRQ_MTVEC        (*(volatile uint32_t *)(IRQ_BASE + 0x10))
+#define IRQ_ACTIVE       (*(volatile uint32_t *)(IRQ_BASE + 0x14))
+#define IRQ_PRIORITY(id) (*(volatile uint32_t *)(IRQ_BASE + 0x20 + 4 * (id)))
+
+// Source IDs (soc_top.sv, section 4)
+#define IRQ_TIMER        1
+#define IRQ_UART_TX      2   // Holding register became free
+#define IRQ_DMA          3   // Reserved: no DMA master yet
+#define IRQ_SOFTWARE     4   // IPI (smp.h send_ipi)
+#define IRQ_SOURCES      4
+
+// Hart-local MSTATUS (cpu_core.sv): MIE gates every interrupt
+#define CSR_MSTATUS      (*(volatile uint32_t *)0x40000020)
+#define MSTATUS_MIE      (1u << 3)
+#define MSTATUS_MPIE     (1u << 7)
+
+#define IRQ_MTVEC_VECTORED 1u
+
+// Helper: Enable source 'id' at 'priority' (1 lowest .. 7 highest)
+static inline void irq_enable(uint32_t id, uint32_t priority) {
+    IRQ_PRIORITY(id) = priority;
+    IRQ_ENABLE |= (1u << id);
+}
+
+static inline void irq_disable(uint32_t id) {
+    IRQ_ENABLE &= ~(1u << id);
+}
+
+// Helper: Direct mode traps to 'base'; vectored mode to base + 4 * ID
+static inline void irq_set_vector(uint32_t base, uint32_t vectored) {
+    IRQ_MTVEC = base | (vectored ? IRQ_MTVEC_VECTORED : 0);
+}
+
+// Helper: Mask interrupts and return the previous MSTATUS for irq_restore()
+static inline uint32_t irq_save(void) {
+    uint32_t status = CSR_MSTATUS;
+    CSR_MSTATUS = status & ~MSTATUS_MIE;
+    return status;
+}
+
+static inline void irq_restore(uint32_t status) {
+    CSR_MSTATUS = status;
+}
+
+// Non-scheduler sources land here (weak default in scheduler.c); runs with
+// MIE set, so higher-priority sources may preempt it.
+void irq_handler(uint32_t id);
+
+#endif
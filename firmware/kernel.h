@@ -0,0 +1,159 @@
+#ifndef KERNEL_H
+#define KERNEL_H
+
+#include <stdint.h>
+#include "pool.h"
+
+// --- KERNEL MEMORY MAP ---
+// crt0.s tags every trace record with the running task read from here
+#define CURRENT_TASK_PTR  ((volatile uint32_t *)0x20000010)
+
+// --- TASKS ---
+// Task 0 is the idle task: whatever called kernel_start(). It runs only
+// when no other task is ready, and the time it spends is counted as idle.
+#define KERNEL_MAX_TASKS  4
+#define KERNEL_IDLE_TASK  0
+
+// Smallest stack task_create() accepts: one trap frame plus some headroom
+#define TASK_FRAME_WORDS  32
+#define TASK_MIN_STACK_WORDS (TASK_FRAME_WORDS + 32)
+
+// Stack high-water marks: new stacks are painted so task_stack_unused()
+// can find the deepest word ever written. Build with
+// -DKERNEL_STACK_CHECK=0 to skip the painting.
+#ifndef KERNEL_STACK_CHECK
+#define KERNEL_STACK_CHECK 1
+#endif
+#define TASK_STACK_PAINT  0x57AC57AC
+
+typedef enum {
+    TASK_FREE = 0,
+    TASK_READY,     // In the run set (running or waiting for the CPU)
+    TASK_SLEEPING,  // On the delta list until its wake tick
+    TASK_BLOCKED    // Waiting on a kernel object
+} task_state_t;
+
+typedef struct task {
+    uint32_t     sp;          // Saved trap frame while not running
+    uint32_t     state;       // task_state_t
+    uint32_t     wake_delta;  // Ticks after the previous sleeper wakes
+    struct task* next;        // Delta list or wait queue link
+    void*        message;     // Queue pointer in transit while blocked
+    uint32_t*    stack;       // Lowest word of the stack
+    uint32_t     stack_words;
+    uint32_t     pooled;      // Stack came from the stack pool
+    uint32_t     id;
+} task_t;
+
+typedef void (*task_entry_t)(void* arg);
+
+// Create a ready task running entry(arg) on a stack from the stack pool
+// (link.ld sizes it). Returns the task ID, or -1 when the task table or
+// the pool is full. Returning from entry ends the task and frees its stack.
+int task_create(task_entry_t entry, void* arg);
+
+// Same, on a caller-provided stack[0..stack_words); -1 also if it is too small
+int task_create_static(task_entry_t entry, void* arg, uint32_t* stack, uint32_t stack_words);
+
+// Stack words never touched so far (0 without KERNEL_STACK_CHECK)
+uint32_t task_stack_unused(uint32_t id);
+
+// Start scheduling; the caller becomes the idle task and never returns
+void kernel_start(void) __attribute__((noreturn));
+
+// Give the CPU to the next ready task (round robin)
+void task_yield(void);
+
+// Leave the run set for 'ticks' timer ticks (TIMER_LIMIT + 1 = 10,001 CPU cycles each);
+// sleep_until() wakes at an absolute kernel_ticks() value instead, so a
+// periodic task does not drift by its own run time.
+void sleep_ticks(uint32_t ticks);
+void sleep_until(uint32_t tick);
+
+// Block until the UART holding register has room (print.h uart_putc);
+// returns at once when the caller cannot block
+void task_wait_uart_tx(void);
+
+// --- SYNCHRONISATION ---
+// Waiters block (leave the run set) and are served in FIFO order. Give,
+// unlock and the try_ calls never block, so interrupt handlers may use
+// sem_give(), sem_try_take() and the queue_try_ calls.
+typedef struct {
+    uint32_t count;
+    task_t*  waiters;
+} sem_t;
+
+typedef struct {
+    task_t*  owner;
+    task_t*  waiters;
+} mutex_t;
+
+// Fixed-slot queue of buffer pointers; the buffer changes owner, the
+// payload is never copied
+typedef struct {
+    void**   slots;
+    uint32_t capacity;   // At least 1
+    uint32_t head;
+    uint32_t count;
+    task_t*  senders;    // Blocked on a full queue
+    task_t*  receivers;  // Blocked on an empty queue
+} queue_t;
+
+void  sem_init(sem_t* sem, uint32_t count);
+void  sem_take(sem_t* sem);
+int   sem_try_take(sem_t* sem);             // 1 if taken
+void  sem_give(sem_t* sem);
+
+void  mutex_init(mutex_t* mutex);
+int   mutex_lock(mutex_t* mutex);           // -1 if the caller already owns it
+int   mutex_unlock(mutex_t* mutex);         // -1 if the caller is not the owner
+
+void  queue_init(queue_t* queue, void** slots, uint32_t capacity);
+void  queue_send(queue_t* queue, void* message);
+void* queue_receive(queue_t* queue);
+int   queue_try_send(queue_t* queue, void* message);        // 1 if sent
+int   queue_try_receive(queue_t* queue, void** message);    // 1 if received
+
+// --- MEMORY POOLS ---
+// Fixed-size blocks (OBJECT_POOL_BLOCK bytes, 64 by default) for kernel
+// objects and message buffers; kernel_alloc() returns 0 when none is left
+void*         kernel_alloc(void);
+void          kernel_free(void* block);
+const pool_t* kernel_stack_pool(void);
+const pool_t* kernel_object_pool(void);
+
+// --- ACCOUNTING ---
+// Kept by scheduler() from the cycle counter (one MMIO load at entry and
+// one at exit). Task time ends at scheduler entry and restarts at its exit;
+// the scheduler's own time is reported separately. Trap entry and exit in
+// crt0.s are charged to the interrupted task. The layout is read by the
+// harness (sim/kernel_stats.h): keep them in step.
+#define KERNEL_STATS_MAGIC 0x4B535431  // "KST1"
+
+typedef struct {
+    uint32_t run_cycles;    // CPU cycles while dispatched
+    uint32_t dispatches;
+    uint32_t preemptions;   // Switched out by the timer while still ready
+    uint32_t voluntary;     // Switched out after yielding, sleeping, blocking or exiting
+    uint32_t max_gap;       // Longest time from switch-out to the next dispatch
+} task_stats_t;
+
+typedef struct {
+    uint32_t     magic;
+    uint32_t     max_tasks;
+    uint32_t     cycles;            // Counter value at kernel_snapshot()
+    uint32_t     scheduler_cycles;  // Total time inside scheduler()
+    uint32_t     scheduler_calls;
+    uint32_t     switches;
+    task_stats_t tasks[KERNEL_MAX_TASKS];
+} kernel_stats_t;
+
+// Copy the counters with interrupts masked, charging the running task up to now
+void kernel_snapshot(kernel_stats_t* snapshot);
+
+uint32_t kernel_ticks(void);
+uint32_t kernel_idle_cycles(void);   // CPU cycles spent in the idle task
+int      kernel_is_running(void);
+uint32_t task_current(void);
+
+#endif
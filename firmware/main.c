@@ -1,41 +1,48 @@
 #include <stdint.h>
 #include "print.h"
+#include "trace.h"
+#include "irq.h"
+#include "kernel.h"
+#include "top.h"
 
-// --- KERNEL MEMORY MAP ---
-#define TASK_PCS          ((volatile uint32_t *)0x20000000)
-#define TASK_SPS          ((volatile uint32_t *)0x20000008)
-#define CURRENT_TASK_PTR  ((volatile uint32_t *)0x20000010)
-
-void task_A(void) {
+// Both tasks sleep between prints; while neither is ready the CPU idles
+void task_A(void* arg) {
+    (void)arg;
     while (1) {
         print_str("A");
-        // Delay loop so we don't spam too fast
-        for (volatile int i = 0; i < 10000; i++); 
+        sleep_ticks(1);
     }
 }
 
-void task_B(void) {
+void task_B(void* arg) {
+    (void)arg;
     while (1) {
         print_str("B");
-        for (volatile int i = 0; i < 10000; i++);
+        sleep_ticks(2);
+    }
+}
+
+// Per-task CPU time and switch counts every 5 ticks
+void task_monitor(void* arg) {
+    (void)arg;
+    while (1) {
+        sleep_ticks(5);
+        print_top();
     }
 }
 
 int main() {
+    trace_init();
+    uart_set_divisor(UART_DIV_HIGH_SPEED);
     print_str("\n[BOOT] Context Switcher Demo\n");
 
-    // 1. Initialize Kernel Data
-    TASK_PCS[0] = (uint32_t)task_A;
-    TASK_PCS[1] = (uint32_t)task_B;
-    *CURRENT_TASK_PTR = 0;
-
-    // 2. Initialize Task B Stack
-    uint32_t* stackB = (uint32_t*)(0x20000800);
-    uint32_t* sp_B = stackB - 32; 
-    sp_B[0] = (uint32_t)task_B; // Set Return Address
-    TASK_SPS[1] = (uint32_t)sp_B; 
+    // 1. Create the tasks (stacks from the pool, ready from the first dispatch)
+    task_create(task_A, 0);
+    task_create(task_B, 0);
+    task_create(task_monitor, 0);
 
-    print_str("[INFO] Starting Task A...\n");
-    task_A(); 
+    // 2. Hand the CPU to the scheduler; main becomes the idle task
+    print_str("[INFO] Starting Tasks A and B...\n");
+    kernel_start();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,60 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdint.h>
+#include "irq.h"
+
+// --- FIXED-BLOCK POOL ALLOCATOR ---
+// Every block in a pool has the same size, so allocation and release pop or
+// push a free list (O(1), no fragmentation). A free block stores the link
+// to the next free block in its first word.
+typedef struct {
+    void*    free;
+    uint32_t block_size;   // Bytes, multiple of 4
+    uint32_t blocks;
+    uint32_t used;
+    uint32_t high_water;   // Most blocks ever in use at once
+} pool_t;
+
+// --- POOL MEMORY (placed by link.ld, section 5) ---
+// Sizes can be overridden at link time, e.g. -Wl,--defsym=STACK_POOL_COUNT=2
+extern uint8_t _stack_pool_start[], _stack_pool_end[];
+extern uint8_t _object_pool_start[], _object_pool_end[];
+extern uint8_t STACK_POOL_BLOCK[], OBJECT_POOL_BLOCK[];   // Absolute: the block sizes
+
+// Helper: Carve [start, end) into blocks of 'block_size' bytes
+static inline void pool_init(pool_t* pool, void* start, void* end, uint32_t block_size) {
+    pool->free       = 0;
+    pool->block_size = block_size;
+    pool->blocks     = 0;
+    pool->used       = 0;
+    pool->high_water = 0;
+    for (uint8_t* block = (uint8_t*)start; block + block_size <= (uint8_t*)end; block += block_size) {
+        *(void**)block = pool->free;
+        pool->free     = block;
+        pool->blocks++;
+    }
+}
+
+// Helper: One block, or 0 when the pool is exhausted
+static inline void* pool_alloc(pool_t* pool) {
+    uint32_t status = irq_save();
+    void* block = pool->free;
+    if (block) {
+        pool->free = *(void**)block;
+        if (++pool->used > pool->high_water) pool->high_water = pool->used;
+    }
+    irq_restore(status);
+    return block;
+}
+
+static inline void pool_free(pool_t* pool, void* block) {
+    if (!block) return;
+    uint32_t status = irq_save();
+    *(void**)block = pool->free;
+    pool->free     = block;
+    pool->used--;
+    irq_restore(status);
+}
+
+#endif
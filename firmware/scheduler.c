@@ -1,60 +1,551 @@
 #include <stdint.h>
+#include "print.h"
+#include "trace.h"
+#include "smp.h"
+#include "irq.h"
+#include "host.h"
+#include "kernel.h"
 
+// Trap frame (crt0.s): 30 registers, then the interrupted PC and MSTATUS
+#define FRAME_RA          0
+#define FRAME_A0          6
+#define FRAME_GP          28
+#define FRAME_MEPC        30
+#define FRAME_MSTATUS     31
 
-#include <stdint.h>
+// --- KERNEL STATE ---
+// Hart 0 owns the task table. Everything here is changed either in the
+// scheduler trap or by a task with interrupts masked (irq_save).
+static struct {
+    task_t            tasks[KERNEL_MAX_TASKS];
+    volatile uint32_t current;
+    volatile uint32_t running;
+    volatile uint32_t ticks;
+    task_t*           sleepers;      // Delta list, earliest wake first
+    uint32_t          uart_waiters;  // Bit per task blocked on the UART holding register
+    uint32_t          yielding;      // The trap being scheduled is a software interrupt
+    uint32_t          run_start;     // Cycle the current task got the CPU back
+    uint32_t          switched_out[KERNEL_MAX_TASKS];
+    pool_t            stack_pool;
+    pool_t            object_pool;
+} kernel;
 
-// UART Registers
-#define UART_TX     (*(volatile uint32_t *)0x40000000)
+// Accounting, updated by every scheduler() call. Not static: the harness
+// finds it by symbol and reads it through the RAM backdoor
+// (sim/kernel_stats.h), so the layout is fixed by kernel_stats_t.
+volatile kernel_stats_t kernel_stats = { .magic = KERNEL_STATS_MAGIC, .max_tasks = KERNEL_MAX_TASKS };
 
-// Helper: Write char to UART (Bypassing Busy Check for Simulation)
-static inline void uart_putc(char c) {
-    UART_TX = c;
-    
-    // Tiny software delay to let the Verilog $write block catch it
-    // This prevents "overwriting" the bus before the simulator notices.
-    for (volatile int i = 0; i < 5; i++); 
+// The pool regions are NOLOAD (link.ld), so the free lists are built here
+// on first use rather than by crt0.s
+static void pools_init(void) {
+    if (kernel.stack_pool.block_size) return;
+    pool_init(&kernel.stack_pool, _stack_pool_start, _stack_pool_end, (uint32_t)STACK_POOL_BLOCK);
+    pool_init(&kernel.object_pool, _object_pool_start, _object_pool_end, (uint32_t)OBJECT_POOL_BLOCK);
 }
 
-// Helper: Print a 32-bit integer as Hex (e.g., "1A2B3C4D")
-static inline void print_hex(uint32_t val) {
-    char hex_chars[] = "0123456789ABCDEF";
-    uart_putc('0'); uart_putc('x');
-    for (int i = 7; i >= 0; i--) {
-        uart_putc(hex_chars[(val >> (i * 4)) & 0xF]);
+// --- 1. DELTA LIST ---
+// Each sleeper stores its wake tick relative to the one before it, so a
+// timer tick only decrements the head and wakes every sleeper that reaches
+// zero; equal wake ticks wake in the order they went to sleep.
+static void sleep_insert(task_t* task, uint32_t ticks) {
+    task_t** link = &kernel.sleepers;
+    while (*link && (*link)->wake_delta <= ticks) {
+        ticks -= (*link)->wake_delta;
+        link   = &(*link)->next;
     }
-    uart_putc(' '); // Space separator
+    task->wake_delta = ticks;
+    task->next       = *link;
+    if (*link) (*link)->wake_delta -= ticks;
+    *link = task;
 }
 
-// Helper: Print a simple string
-static inline void print_str(const char* s) {
-
-        uart_putc(*s++);
-
+static void kernel_tick(void) {
+    kernel.ticks++;
+    if (!kernel.sleepers) return;
+    kernel.sleepers->wake_delta--;
+    while (kernel.sleepers && kernel.sleepers->wake_delta == 0) {
+        task_t* task     = kernel.sleepers;
+        kernel.sleepers  = task->next;
+        task->next       = 0;
+        task->state      = TASK_READY;
+    }
 }
 
+// --- 2. SCHEDULER ---
+// Round robin over the ready tasks, starting after the current one (which
+// is picked again only if nobody else is ready). The idle task runs when
+// the run set is empty.
+static uint32_t pick_next(void) {
+    uint32_t candidate = kernel.current;
+    for (uint32_t i = 1; i < KERNEL_MAX_TASKS; i++) {
+        candidate = (candidate + 1 == KERNEL_MAX_TASKS) ? 1 : candidate + 1;
+        if (kernel.tasks[candidate].state == TASK_READY) return candidate;
+    }
+    return KERNEL_IDLE_TASK;
+}
 
-#define CSR_MEPC (*(volatile uint32_t *)0x40000010)
+uint32_t scheduler(uint32_t current_sp) {
+    // Only hart 0 owns the task table; other harts (and programs that never
+    // call kernel_start) resume the interrupted context unchanged.
+    if (hart_id() != 0 || !kernel.running) return current_sp;
 
-// Memory Map
-#define TASK_PCS          ((volatile uint32_t *)0x20000000)
-#define TASK_SPS          ((volatile uint32_t *)0x20000008)
-#define CURRENT_TASK_PTR  ((volatile uint32_t *)0x20000010)
+    // One MMIO load each way: the task is charged up to scheduler entry and
+    // from scheduler exit, the time in between is scheduler overhead
+    uint32_t entry        = HOST_CYCLE_LO;
+    uint32_t current_task = kernel.current;
+    volatile task_stats_t* stats = kernel_stats.tasks;
+    stats[current_task].run_cycles += entry - kernel.run_start;
 
-uint32_t scheduler(uint32_t current_sp) {
-    int current_task = *CURRENT_TASK_PTR;
+    // 1. Save Context (the resume PC travels in the frame). A task that has
+    // exited is off its stack from here on, so a pool stack goes back now.
+    task_t* current = &kernel.tasks[current_task];
+    current->sp = current_sp;
+    if (current->state == TASK_FREE && current->pooled) {
+        pool_free(&kernel.stack_pool, current->stack);
+        current->pooled = 0;
+    }
 
-    // 1. Save Context
-    TASK_SPS[current_task] = current_sp;
-    TASK_PCS[current_task] = CSR_MEPC; 
+    // 2. Pick the next ready task
+    uint32_t next_task = pick_next();
+    if (next_task != current_task) {
+        trace_event(TRACE_SWITCH, current_task, next_task);
+        // Still ready after a timer trap: preempted. Otherwise it yielded,
+        // slept, blocked or exited.
+        if (current->state == TASK_READY && !kernel.yielding) stats[current_task].preemptions++;
+        else                                                  stats[current_task].voluntary++;
+        kernel.switched_out[current_task] = entry;
 
-    // 2. Toggle Task (0 -> 1 -> 0)
-    int next_task = (current_task == 0) ? 1 : 0;
-    
-    // The scheduler must be fast.
+        uint32_t gap = entry - kernel.switched_out[next_task];
+        if (stats[next_task].dispatches && gap > stats[next_task].max_gap) stats[next_task].max_gap = gap;
+        stats[next_task].dispatches++;
+        kernel_stats.switches++;
+    }
 
     // 3. Restore Context
+    kernel.current    = next_task;
     *CURRENT_TASK_PTR = next_task;
-    CSR_MEPC = TASK_PCS[next_task];
-    
-    return TASK_SPS[next_task];
-}
\ No newline at end of file
+
+    uint32_t exit = HOST_CYCLE_LO;
+    kernel_stats.scheduler_cycles += exit - entry;
+    kernel_stats.scheduler_calls++;
+    kernel.run_start = exit;
+    return kernel.tasks[next_task].sp;
+}
+
+// Default handler for sources other than the timer, IPIs and the UART
+__attribute__((weak)) void irq_handler(uint32_t id) {
+    (void)id;
+}
+
+// Called from trap_vector with MIE set: the timer tick (lowest priority)
+// can be preempted by any I/O source enabled above it.
+uint32_t irq_dispatch(uint32_t id, uint32_t current_sp) {
+    if (id == IRQ_TIMER || id == IRQ_SOFTWARE) {
+        if (id == IRQ_TIMER && hart_id() == 0) kernel_tick();
+        kernel.yielding = (id == IRQ_SOFTWARE);
+        return scheduler(current_sp);
+    }
+    if (id == IRQ_UART_TX && hart_id() == 0 && kernel.uart_waiters) {
+        // Holding register drained: every waiter retries its write
+        irq_disable(IRQ_UART_TX);
+        for (uint32_t task = 1; task < KERNEL_MAX_TASKS; task++) {
+            if (kernel.uart_waiters & (1u << task)) kernel.tasks[task].state = TASK_READY;
+        }
+        kernel.uart_waiters = 0;
+        kernel.yielding = 1;
+        return (kernel.current == KERNEL_IDLE_TASK) ? scheduler(current_sp) : current_sp;
+    }
+    irq_handler(id);
+    return current_sp;
+}
+
+// --- 3. TASK API ---
+static void task_exit(void) {
+    uint32_t status = irq_save();
+    kernel.tasks[kernel.current].state = TASK_FREE;
+    IRQ_PENDING = 1u << IRQ_SOFTWARE;
+    irq_restore(status);
+    while (1);
+}
+
+static int task_setup(task_entry_t entry, void* arg, uint32_t* stack, uint32_t stack_words, uint32_t pooled) {
+    uint32_t status = irq_save();
+    int id = -1;
+    for (uint32_t i = 1; i < KERNEL_MAX_TASKS; i++) {
+        if (kernel.tasks[i].state == TASK_FREE) { id = i; break; }
+    }
+    if (id < 0) {
+        irq_restore(status);
+        return -1;
+    }
+
+    // First dispatch "returns" from a trap into entry(arg) with MIE set
+    uint32_t* frame = stack + stack_words - TASK_FRAME_WORDS;
+    uint32_t  gp;
+    __asm__ volatile ("mv %0, gp" : "=r"(gp));
+#if KERNEL_STACK_CHECK
+    for (uint32_t* word = stack; word < frame; word++) *word = TASK_STACK_PAINT;
+#endif
+    for (int i = 0; i < TASK_FRAME_WORDS; i++) frame[i] = 0;
+    frame[FRAME_RA]      = (uint32_t)task_exit;
+    frame[FRAME_A0]      = (uint32_t)arg;
+    frame[FRAME_GP]      = gp;
+    frame[FRAME_MEPC]    = (uint32_t)entry;
+    frame[FRAME_MSTATUS] = MSTATUS_MPIE;
+
+    task_t* task = &kernel.tasks[id];
+    task->id    = id;
+    task->sp          = (uint32_t)frame;
+    task->next        = 0;
+    task->stack       = stack;
+    task->stack_words = stack_words;
+    task->pooled      = pooled;
+    task->state       = TASK_READY;
+    trace_event(TRACE_TASK_CREATE, id, (uint32_t)entry);
+    irq_restore(status);
+    return id;
+}
+
+int task_create_static(task_entry_t entry, void* arg, uint32_t* stack, uint32_t stack_words) {
+    if (stack_words < TASK_MIN_STACK_WORDS) return -1;
+    return task_setup(entry, arg, stack, stack_words, 0);
+}
+
+int task_create(task_entry_t entry, void* arg) {
+    pools_init();
+    uint32_t* stack = pool_alloc(&kernel.stack_pool);
+    if (!stack) return -1;
+    int id = task_setup(entry, arg, stack, kernel.stack_pool.block_size >> 2, 1);
+    if (id < 0) pool_free(&kernel.stack_pool, stack);
+    return id;
+}
+
+uint32_t task_stack_unused(uint32_t id) {
+#if KERNEL_STACK_CHECK
+    task_t*  task   = &kernel.tasks[id];
+    uint32_t unused = 0;
+    if (id == KERNEL_IDLE_TASK || id >= KERNEL_MAX_TASKS || !task->stack) return 0;
+    while (unused < task->stack_words && task->stack[unused] == TASK_STACK_PAINT) unused++;
+    return unused;
+#else
+    (void)id;
+    return 0;
+#endif
+}
+
+void kernel_start(void) {
+    uint32_t status = irq_save();
+    kernel.tasks[KERNEL_IDLE_TASK].state = TASK_READY;
+    kernel.current    = KERNEL_IDLE_TASK;
+    *CURRENT_TASK_PTR = KERNEL_IDLE_TASK;
+    kernel.run_start  = HOST_CYCLE_LO;
+    kernel_stats.tasks[KERNEL_IDLE_TASK].dispatches = 1;
+    kernel.running    = 1;
+    IRQ_PENDING = 1u << IRQ_SOFTWARE; // Dispatch the first task right away
+    irq_restore(status | MSTATUS_MIE);
+
+    // Idle task: nothing is ready (no WFI on this core, so it spins)
+    while (1);
+}
+
+void task_yield(void) {
+    trace_event(TRACE_YIELD, kernel.current, 0);
+    IRQ_PENDING = 1u << IRQ_SOFTWARE;
+}
+
+// Take the caller out of the run set (interrupts already masked) and wait
+// until the scheduler hands it the CPU back. The software trap is taken as
+// soon as MIE returns, but a couple of instructions may retire first, so
+// the task spins on its own state rather than trusting the trap latency.
+static void block_current(uint32_t state, uint32_t status) {
+    volatile task_t* self = &kernel.tasks[kernel.current];
+    self->state = state;
+    IRQ_PENDING = 1u << IRQ_SOFTWARE;
+    irq_restore(status);
+    while (self->state != TASK_READY);
+}
+
+// Tasks can only block on hart 0, with interrupts on and outside a handler;
+// anywhere else (and in the idle task) the sleeps below fall back to polling.
+static int can_block(uint32_t status) {
+    return kernel.running && hart_id() == 0 && kernel.current != KERNEL_IDLE_TASK &&
+           (status & MSTATUS_MIE) && IRQ_ACTIVE == 0;
+}
+
+void sleep_until(uint32_t tick) {
+    uint32_t status = irq_save();
+    int32_t  remaining = (int32_t)(tick - kernel.ticks);
+    if (remaining <= 0) {
+        irq_restore(status);
+        return;
+    }
+    if (!can_block(status)) {
+        irq_restore(status);
+        while ((int32_t)(tick - kernel.ticks) > 0);
+        return;
+    }
+    sleep_insert(&kernel.tasks[kernel.current], (uint32_t)remaining);
+    block_current(TASK_SLEEPING, status);
+}
+
+void sleep_ticks(uint32_t ticks) {
+    if (ticks == 0) {
+        task_yield();
+        return;
+    }
+    sleep_until(kernel.ticks + ticks);
+}
+
+// print.h: wait for the UART holding register without spinning
+void task_wait_uart_tx(void) {
+    if (!kernel.running) return;
+    uint32_t status = irq_save();
+    if (!(UART_STATUS & UART_STATUS_FULL) || !can_block(status)) {
+        irq_restore(status);
+        return;
+    }
+    // A drain between the status read and here still latches the pending
+    // bit, so enabling the source afterwards cannot miss it
+    kernel.uart_waiters |= 1u << kernel.current;
+    irq_enable(IRQ_UART_TX, 1);
+    block_current(TASK_BLOCKED, status);
+}
+
+// --- 4. SYNCHRONISATION ---
+// Blocked tasks wait in FIFO order, linked through task->next (a blocked
+// task is never on the delta list). A release hands the object straight to
+// the first waiter, so a woken task never has to retry: its count, lock or
+// message is already taken when block_current() returns.
+static void wait_enqueue(task_t** queue, task_t* task) {
+    while (*queue) queue = &(*queue)->next;
+    task->next = 0;
+    *queue     = task;
+}
+
+static task_t* wait_dequeue(task_t** queue) {
+    task_t* task = *queue;
+    if (task) {
+        *queue     = task->next;
+        task->next = 0;
+    }
+    return task;
+}
+
+// The woken task runs at the next switch. If only the idle task was
+// running (a release from an interrupt handler), request that switch now
+// through the software interrupt, which is taken after every handler has
+// completed, never inside a nested one.
+static void wake(task_t* task) {
+    task->state = TASK_READY;
+    if (kernel.running && kernel.current == KERNEL_IDLE_TASK) IRQ_PENDING = 1u << IRQ_SOFTWARE;
+}
+
+void sem_init(sem_t* sem, uint32_t count) {
+    sem->count   = count;
+    sem->waiters = 0;
+}
+
+void sem_take(sem_t* sem) {
+    while (1) {
+        uint32_t status = irq_save();
+        if (sem->count) {
+            sem->count--;
+            irq_restore(status);
+            return;
+        }
+        if (can_block(status)) {
+            wait_enqueue(&sem->waiters, &kernel.tasks[kernel.current]);
+            block_current(TASK_BLOCKED, status);
+            return;
+        }
+        irq_restore(status);
+    }
+}
+
+int sem_try_take(sem_t* sem) {
+    uint32_t status = irq_save();
+    int taken = sem->count != 0;
+    if (taken) sem->count--;
+    irq_restore(status);
+    return taken;
+}
+
+void sem_give(sem_t* sem) {
+    uint32_t status = irq_save();
+    task_t* waiter = wait_dequeue(&sem->waiters);
+    if (waiter) wake(waiter);
+    else        sem->count++;
+    irq_restore(status);
+}
+
+void mutex_init(mutex_t* mutex) {
+    mutex->owner   = 0;
+    mutex->waiters = 0;
+}
+
+int mutex_lock(mutex_t* mutex) {
+    while (1) {
+        uint32_t status = irq_save();
+        task_t*  self   = &kernel.tasks[kernel.current];
+        if (mutex->owner == self) {
+            irq_restore(status);
+            return -1;  // Not recursive
+        }
+        if (!mutex->owner) {
+            mutex->owner = self;
+            irq_restore(status);
+            return 0;
+        }
+        if (can_block(status)) {
+            wait_enqueue(&mutex->waiters, self);
+            block_current(TASK_BLOCKED, status);
+            return 0;
+        }
+        irq_restore(status);
+    }
+}
+
+int mutex_unlock(mutex_t* mutex) {
+    uint32_t status = irq_save();
+    if (mutex->owner != &kernel.tasks[kernel.current]) {
+        irq_restore(status);
+        return -1;
+    }
+    mutex->owner = wait_dequeue(&mutex->waiters);
+    if (mutex->owner) wake(mutex->owner);
+    irq_restore(status);
+    return 0;
+}
+
+// Queues hold pointers only: the sender gives up the buffer and the
+// receiver owns it from then on, so a message of any size costs a few
+// stores. A sender blocked on a full queue parks its pointer in its task
+// slot; the receiver that frees a slot moves it into the ring.
+void queue_init(queue_t* queue, void** slots, uint32_t capacity) {
+    queue->slots     = slots;
+    queue->capacity  = capacity;
+    queue->head      = 0;
+    queue->count     = 0;
+    queue->senders   = 0;
+    queue->receivers = 0;
+}
+
+static void queue_push(queue_t* queue, void* message) {
+    uint32_t tail = queue->head + queue->count;
+    if (tail >= queue->capacity) tail -= queue->capacity;
+    queue->slots[tail] = message;
+    queue->count++;
+}
+
+static void* queue_pop(queue_t* queue) {
+    void* message = queue->slots[queue->head];
+    queue->head   = (queue->head + 1 == queue->capacity) ? 0 : queue->head + 1;
+    queue->count--;
+    return message;
+}
+
+// Either hands 'message' to a waiting receiver or queues it; 0 when full
+static int queue_put(queue_t* queue, void* message) {
+    task_t* receiver = wait_dequeue(&queue->receivers);
+    if (receiver) {
+        receiver->message = message;
+        wake(receiver);
+        return 1;
+    }
+    if (queue->count == queue->capacity) return 0;
+    queue_push(queue, message);
+    return 1;
+}
+
+// Takes the oldest message and refills the slot from a blocked sender
+static int queue_get(queue_t* queue, void** message) {
+    if (!queue->count) return 0;
+    *message = queue_pop(queue);
+    task_t* sender = wait_dequeue(&queue->senders);
+    if (sender) {
+        queue_push(queue, sender->message);
+        wake(sender);
+    }
+    return 1;
+}
+
+void queue_send(queue_t* queue, void* message) {
+    while (1) {
+        uint32_t status = irq_save();
+        if (queue_put(queue, message)) {
+            irq_restore(status);
+            return;
+        }
+        if (can_block(status)) {
+            task_t* self  = &kernel.tasks[kernel.current];
+            self->message = message;
+            wait_enqueue(&queue->senders, self);
+            block_current(TASK_BLOCKED, status);
+            return;
+        }
+        irq_restore(status);
+    }
+}
+
+void* queue_receive(queue_t* queue) {
+    void* message;
+    while (1) {
+        uint32_t status = irq_save();
+        if (queue_get(queue, &message)) {
+            irq_restore(status);
+            return message;
+        }
+        if (can_block(status)) {
+            task_t* self = &kernel.tasks[kernel.current];
+            wait_enqueue(&queue->receivers, self);
+            block_current(TASK_BLOCKED, status);
+            return self->message;
+        }
+        irq_restore(status);
+    }
+}
+
+int queue_try_send(queue_t* queue, void* message) {
+    uint32_t status = irq_save();
+    int sent = queue_put(queue, message);
+    irq_restore(status);
+    return sent;
+}
+
+int queue_try_receive(queue_t* queue, void** message) {
+    uint32_t status = irq_save();
+    int received = queue_get(queue, message);
+    irq_restore(status);
+    return received;
+}
+
+// --- 5. MEMORY POOLS ---
+void* kernel_alloc(void) {
+    pools_init();
+    return pool_alloc(&kernel.object_pool);
+}
+
+void kernel_free(void* block) {
+    pool_free(&kernel.object_pool, block);
+}
+
+const pool_t* kernel_stack_pool(void)  { pools_init(); return &kernel.stack_pool; }
+const pool_t* kernel_object_pool(void) { pools_init(); return &kernel.object_pool; }
+
+// --- 6. ACCOUNTING ---
+// Consistent copy of kernel_stats; the running task is charged up to now
+void kernel_snapshot(kernel_stats_t* snapshot) {
+    uint32_t status = irq_save();
+    uint32_t now    = HOST_CYCLE_LO;
+    const volatile uint32_t* from = (const volatile uint32_t*)&kernel_stats;
+    uint32_t*                to   = (uint32_t*)snapshot;
+    for (uint32_t i = 0; i < sizeof(kernel_stats_t) / 4; i++) to[i] = from[i];
+    if (kernel.running) snapshot->tasks[kernel.current].run_cycles += now - kernel.run_start;
+    snapshot->cycles = now;
+    irq_restore(status);
+}
+
+uint32_t kernel_ticks(void)       { return kernel.ticks; }
+uint32_t kernel_idle_cycles(void) { return kernel_stats.tasks[KERNEL_IDLE_TASK].run_cycles; }
+int      kernel_is_running(void)  { return kernel.running; }
+uint32_t task_current(void)       { return kernel.current; }
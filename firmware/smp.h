@@ -0,0 +1,31 @@
+#ifndef SMP_H
+#define SMP_H
+
+#include <stdint.h>
+
+// --- HART REGISTERS ---
+// MHARTID is answered inside each hart (cpu_core.sv), so every hart reads its own index.
+#define SMP_MHARTID    (*(volatile uint32_t *)0x40000014)
+#define SMP_IPI        (*(volatile uint32_t *)0x40000018) // W: hart mask, one interrupt per set bit
+#define SMP_NUM_HARTS  (*(volatile uint32_t *)0x4000001C)
+
+// Each hart boots on its own stack below the top of RAM (crt0.s); link.ld
+// reserves HARTS of them and sizes them with --defsym=SMP_STACK_SIZE=<bytes>
+extern uint8_t SMP_STACK_SIZE[];   // Absolute: bytes per hart
+
+// Helper: Index of the calling hart (0 boots main)
+static inline uint32_t hart_id(void) {
+    return SMP_MHARTID;
+}
+
+// Helper: Harts in this build of soc_top (HARTS parameter)
+static inline uint32_t num_harts(void) {
+    return SMP_NUM_HARTS;
+}
+
+// Helper: Trap every hart in 'mask' into its scheduler
+static inline void send_ipi(uint32_t mask) {
+    SMP_IPI = mask;
+}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef TOP_H
+#define TOP_H
+
+#include <stdint.h>
+#include "print.h"
+#include "kernel.h"
+
+// --- TASK MONITOR ---
+// A tiny 'top' over kernel_snapshot(); all figures in hex CPU cycles.
+// The snapshot is static so a monitor task does not need a large stack.
+static kernel_stats_t top_snapshot;
+
+static inline void print_top(void) {
+    kernel_snapshot(&top_snapshot);
+    print_str("[TOP] task       run-cycles dispatches preempted  voluntary  max-gap\n");
+    for (uint32_t id = 0; id < top_snapshot.max_tasks; id++) {
+        task_stats_t* task = &top_snapshot.tasks[id];
+        if (!task->dispatches) continue;
+        print_str("[TOP] ");
+        print_hex(id);
+        print_hex(task->run_cycles);
+        print_hex(task->dispatches);
+        print_hex(task->preemptions);
+        print_hex(task->voluntary);
+        print_hex(task->max_gap);
+        print_str(id == KERNEL_IDLE_TASK ? "(idle)\n" : "\n");
+    }
+    print_str("[TOP] scheduler ");
+    print_hex(top_snapshot.scheduler_cycles);
+    print_str("cycles in ");
+    print_hex(top_snapshot.scheduler_calls);
+    print_str("calls, uptime ");
+    print_hex(top_snapshot.cycles);
+    print_str("\n");
+}
+
+#endif
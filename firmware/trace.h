@@ -0,0 +1,44 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include "atomic.h"
+
+// --- KERNEL EVENT TRACE RING ---
+// Binary ring buffer in RAM, decoded by the harness (sim/kernel_trace.h).
+// Layout: [0] total events written, [4] magic, [8..] entries of 2 words:
+//   word 0: cycle counter at the event
+//   word 1: type[31:24] | task[23:16] | arg[15:0]
+// crt0.s appends IRQ entry/exit records with the same layout.
+#define TRACE_BASE      0x20000100
+#define TRACE_COUNT     (*(volatile uint32_t *)(TRACE_BASE + 0))
+#define TRACE_MAGIC_REG (*(volatile uint32_t *)(TRACE_BASE + 4))
+#define TRACE_ENTRIES   ((volatile uint32_t *)(TRACE_BASE + 8))
+#define TRACE_CAPACITY  32          // Entries, power of two
+#define TRACE_MAGIC     0x54524331  // "TRC1"
+
+#define TRACE_CYCLES    (*(volatile uint32_t *)0x40000108)
+
+// Event Types
+#define TRACE_IRQ_ENTER   1
+#define TRACE_IRQ_EXIT    2
+#define TRACE_SWITCH      3   // arg = next task
+#define TRACE_TASK_CREATE 4   // arg = entry point [15:0]
+#define TRACE_YIELD       5
+
+static inline void trace_init(void) {
+    TRACE_COUNT     = 0;
+    TRACE_MAGIC_REG = TRACE_MAGIC;
+}
+
+// One AMO, two stores and no branches: cheap enough to leave enabled in the
+// kernel, and a trap between claiming the slot and filling it cannot hand
+// the same slot to the trap handler.
+static inline void trace_event(uint32_t type, uint32_t task, uint32_t arg) {
+    uint32_t index = atomic_fetch_add(&TRACE_COUNT, 1);
+    volatile uint32_t* entry = &TRACE_ENTRIES[(index & (TRACE_CAPACITY - 1)) * 2];
+    entry[0] = TRACE_CYCLES;
+    entry[1] = (type << 24) | ((task & 0xFF) << 16) | (arg & 0xFFFF);
+}
+
+#endif
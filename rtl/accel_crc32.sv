@@ -0,0 +1,68 @@
+module accel_crc32 #(
+    parameter bitsPerCycle = 8 // 32: any step in one cycle, 8: one byte per cycle (a word takes 4)
+) (
+    input  logic        clock,
+    input  logic        resetActiveLow,
+
+    // Accelerator Port (cpu_core.sv)
+    input  logic        accelValid,     // custom instruction waiting in the core
+    input  logic        accelCustom1,   // 0: custom-0, 1: custom-1
+    input  logic [2:0]  accelFunct3,
+    input  logic [6:0]  accelFunct7,
+    input  logic [31:0] accelOperandA,  // rs1
+    input  logic [31:0] accelOperandB,  // rs2
+    output logic [31:0] accelResult,    // rd, taken on the edge where accelReady is high
+    output logic        accelReady
+);
+
+    // CRC-32 step (reflected polynomial 0xEDB88320, as used by Ethernet/zlib),
+    // on custom-0 with funct7 = 0. rs1 is the running CRC; the initial value
+    // and the final inversion are left to software.
+    //   funct3 000: crc32.b  rd = step(rs1 ^ rs2[7:0], 8 bits)
+    //   funct3 010: crc32.w  rd = step(rs1 ^ rs2, 32 bits), rs2 little-endian
+    // Any other encoding completes at once with rd = 0.
+    localparam logic [31:0] polynomial = 32'hEDB88320;
+
+    function automatic logic [31:0] crcShift(input logic [31:0] value, input logic [5:0] bits);
+        for (int index = 0; index < 32; index++) begin
+            if (index < int'(bits)) value = (value >> 1) ^ (polynomial & {32{value[0]}});
+        end
+        return value;
+    endfunction
+
+    logic        isCrc;
+    logic [5:0]  totalBits, remainingBits;
+    logic [31:0] seed, partialCrc;
+    logic        busy;
+
+    assign isCrc     = !accelCustom1 && accelFunct7 == 7'b0 && (accelFunct3 == 3'b000 || accelFunct3 == 3'b010);
+    assign totalBits = (accelFunct3 == 3'b010) ? 6'd32 : 6'd8;
+    assign seed      = accelOperandA ^ ((accelFunct3 == 3'b010) ? accelOperandB : {24'b0, accelOperandB[7:0]});
+
+    // --- 1. HANDSHAKE ---
+    // A step that fits in bitsPerCycle is combinational (ready at once).
+    // Longer steps latch the operands, shift bitsPerCycle bits per cycle and
+    // finish the remainder combinationally in the ready cycle. Dropping
+    // accelValid (a trap cancelled the instruction) abandons the step.
+    assign accelReady  = !isCrc || (busy ? (remainingBits <= 6'(bitsPerCycle)) : (totalBits <= 6'(bitsPerCycle)));
+    assign accelResult = !isCrc ? 32'b0 :
+                         busy   ? crcShift(partialCrc, remainingBits) : crcShift(seed, totalBits);
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            busy          <= 1'b0;
+            remainingBits <= 6'd0;
+            partialCrc    <= 32'b0;
+        end else if (!accelValid || accelReady) begin
+            busy          <= 1'b0;  // Idle, cancelled, or the result is taken this edge
+        end else if (!busy) begin
+            busy          <= 1'b1;
+            partialCrc    <= crcShift(seed, 6'(bitsPerCycle));
+            remainingBits <= totalBits - 6'(bitsPerCycle);
+        end else begin
+            partialCrc    <= crcShift(partialCrc, 6'(bitsPerCycle));
+            remainingBits <= remainingBits - 6'(bitsPerCycle);
+        end
+    end
+
+endmodule
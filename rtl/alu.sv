@@ -1,19 +1,81 @@
 module alu (
     input  logic [31:0] inputA,     // Operand A
     input  logic [31:0] inputB,     // Operand B
-    input  logic [2:0]  aluControl, // Opcode: determines the operation
+    input  logic [4:0]  aluControl, // Opcode: determines the operation
     output logic [31:0] aluResult,  
     output logic        zero        // High if aluResult is zero
 );
 
+    // --- 1. BIT-COUNT HELPERS (Zbb) ---
+    logic [5:0] leadingZeros, trailingZeros, populationCount;
+
+    always_comb begin
+        leadingZeros = 6'd32;
+        for (int i = 0; i < 32; i++) begin
+            if (inputA[i]) leadingZeros = 6'(31 - i); // Highest set bit wins
+        end
+    end
+
+    always_comb begin
+        trailingZeros = 6'd32;
+        for (int i = 31; i >= 0; i--) begin
+            if (inputA[i]) trailingZeros = 6'(i);     // Lowest set bit wins
+        end
+    end
+
+    always_comb begin
+        populationCount = 6'd0;
+        for (int i = 0; i < 32; i++) populationCount = populationCount + 6'(inputA[i]);
+    end
+
+    // --- 2. RESULT MUX ---
     always_comb begin
         case (aluControl)
-            3'b000:  aluResult = inputA + inputB;                 // ADD
-            3'b001:  aluResult = inputA - inputB;                 // SUB
-            3'b010:  aluResult = inputA & inputB;                 // AND
-            3'b011:  aluResult = inputA | inputB;                 // OR
-            3'b100:  aluResult = inputA ^ inputB;                 // XOR
-            3'b101:  aluResult = (inputA < inputB) ? 32'b1 : 32'b0; // SLT (Set Less Than)
+            5'd0:    aluResult = inputA + inputB;                 // ADD
+            5'd1:    aluResult = inputA - inputB;                 // SUB
+            5'd2:    aluResult = inputA & inputB;                 // AND
+            5'd3:    aluResult = inputA | inputB;                 // OR
+            5'd4:    aluResult = inputA ^ inputB;                 // XOR
+            5'd5:    aluResult = ($signed(inputA) < $signed(inputB)) ? 32'b1 : 32'b0; // SLT (Set Less Than)
+
+            // Zbb: logic with negate
+            5'd6:    aluResult = inputA & ~inputB;                // ANDN
+            5'd7:    aluResult = inputA | ~inputB;                // ORN
+            5'd8:    aluResult = ~(inputA ^ inputB);              // XNOR
+
+            // Zbb: bit counts (operand A only)
+            5'd9:    aluResult = {26'b0, leadingZeros};           // CLZ
+            5'd10:   aluResult = {26'b0, trailingZeros};          // CTZ
+            5'd11:   aluResult = {26'b0, populationCount};        // CPOP
+
+            // Zbb: rotates (amount in B[4:0], RORI passes shamt as the immediate)
+            5'd12:   aluResult = (inputA << inputB[4:0]) | (inputA >> (6'd32 - {1'b0, inputB[4:0]})); // ROL
+            5'd13:   aluResult = (inputA >> inputB[4:0]) | (inputA << (6'd32 - {1'b0, inputB[4:0]})); // ROR
+
+            // Zbb: min/max
+            5'd14:   aluResult = ($signed(inputA) < $signed(inputB)) ? inputA : inputB; // MIN
+            5'd15:   aluResult = ($signed(inputA) < $signed(inputB)) ? inputB : inputA; // MAX
+            5'd16:   aluResult = (inputA < inputB) ? inputA : inputB;                   // MINU
+            5'd17:   aluResult = (inputA < inputB) ? inputB : inputA;                   // MAXU
+
+            // Zba: shifted add (rs1 scaled, rs2 added)
+            5'd18:   aluResult = {inputA[30:0], 1'b0}  + inputB;  // SH1ADD
+            5'd19:   aluResult = {inputA[29:0], 2'b0}  + inputB;  // SH2ADD
+            5'd20:   aluResult = {inputA[28:0], 3'b0}  + inputB;  // SH3ADD
+
+            // Zbb: byte and extension ops (operand A only)
+            5'd21:   aluResult = {inputA[7:0], inputA[15:8], inputA[23:16], inputA[31:24]}; // REV8
+            5'd22:   aluResult = {{8{|inputA[31:24]}}, {8{|inputA[23:16]}},
+                                  {8{|inputA[15:8]}},  {8{|inputA[7:0]}}};                   // ORC.B
+            5'd23:   aluResult = {{24{inputA[7]}},  inputA[7:0]};  // SEXT.B
+            5'd24:   aluResult = {{16{inputA[15]}}, inputA[15:0]}; // SEXT.H
+            5'd25:   aluResult = {16'b0, inputA[15:0]};            // ZEXT.H
+
+            // Base shifts and unsigned compare (shift amount in B[4:0])
+            5'd26:   aluResult = (inputA < inputB) ? 32'b1 : 32'b0; // SLTU
+            5'd27:   aluResult = inputA << inputB[4:0];            // SLL
+            5'd28:   aluResult = inputA >> inputB[4:0];            // SRL
+            5'd29:   aluResult = $unsigned($signed(inputA) >>> inputB[4:0]); // SRA
             default: aluResult = 32'b0;                           // Default / NOP
         endcase
     end
@@ -21,4 +83,4 @@ module alu (
     // Status flag logic
     assign zero = (aluResult == 32'b0);
 
-endmodule
\ No newline at end of file
+endmodule
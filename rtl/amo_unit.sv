@@ -0,0 +1,25 @@
+module amo_unit (
+    input  logic [4:0]  amoFunct5,    // instruction[31:27]: selects the read-modify-write operation
+    input  logic [31:0] memoryValue,  // Word read from the bus this cycle (old value, returned in rd)
+    input  logic [31:0] operandValue, // rs2
+    output logic [31:0] storeValue    // Word written back to the same address
+);
+
+    // AMO*.W operations (RV32A). LR.W/SC.W do not use this unit: LR only
+    // reads, and SC stores rs2 unchanged if the bus reservation holds.
+    always_comb begin
+        case (amoFunct5)
+            5'b00001: storeValue = operandValue;                                      // AMOSWAP
+            5'b00000: storeValue = memoryValue + operandValue;                        // AMOADD
+            5'b00100: storeValue = memoryValue ^ operandValue;                        // AMOXOR
+            5'b01100: storeValue = memoryValue & operandValue;                        // AMOAND
+            5'b01000: storeValue = memoryValue | operandValue;                        // AMOOR
+            5'b10000: storeValue = ($signed(memoryValue) < $signed(operandValue)) ? memoryValue : operandValue; // AMOMIN
+            5'b10100: storeValue = ($signed(memoryValue) < $signed(operandValue)) ? operandValue : memoryValue; // AMOMAX
+            5'b11000: storeValue = (memoryValue < operandValue) ? memoryValue : operandValue;                   // AMOMINU
+            5'b11100: storeValue = (memoryValue < operandValue) ? operandValue : memoryValue;                   // AMOMAXU
+            default:  storeValue = memoryValue;                                       // Unknown: write back unchanged
+        endcase
+    end
+
+endmodule
@@ -1,16 +1,22 @@
-module bus_interconnect (
+module bus_interconnect #(
+    parameter HARTS   = 1, // CPU harts sharing the CPU master port (see hart_arbiter.sv)
+    parameter ID_BITS = (HARTS > 1) ? $clog2(HARTS) : 1
+) (
     input  logic        clock,
     input  logic        resetActiveLow,
 
     // CPU MASTER
     input  logic [31:0] cpuAxiWriteAddress,   input  logic cpuAxiWriteValid,     output logic cpuAxiWriteReady,
     input  logic [31:0] cpuAxiWriteData,      input  logic cpuAxiWriteValidData, output logic cpuAxiWriteReadyData,
+    input  logic [3:0]  cpuAxiWriteStrobe,    // Byte lanes of cpuAxiWriteData to write
     input  logic [31:0] cpuAxiReadAddress,    input  logic cpuAxiReadValid,      output logic cpuAxiReadReady,
+    input  logic [3:0]  cpuAxiReadStrobe,     // Byte lanes of cpuAxiReadData the load uses (byte counters only)
     output logic [31:0] cpuAxiReadData,       output logic cpuAxiReadValidData,  input  logic cpuAxiReadReadyData,
 
     // DMA MASTER
     input  logic [31:0] dmaAxiWriteAddress,   input  logic dmaAxiWriteValid,     output logic dmaAxiWriteReady,
     input  logic [31:0] dmaAxiWriteData,      input  logic dmaAxiWriteValidData, output logic dmaAxiWriteReadyData,
+    input  logic [3:0]  dmaAxiWriteStrobe,
     input  logic [31:0] dmaAxiReadAddress,    input  logic dmaAxiReadValid,      output logic dmaAxiReadReady,
     output logic [31:0] dmaAxiReadData,       output logic dmaAxiReadValidData,  input  logic dmaAxiReadReadyData,
 
@@ -20,13 +26,27 @@ module bus_interconnect (
 
     output logic [31:0] ramAxiWriteAddress,   output logic ramAxiWriteValid,     input  logic ramAxiWriteReady,
     output logic [31:0] ramAxiWriteData,      output logic ramAxiWriteValidData, input  logic ramAxiWriteReadyData,
+    output logic [3:0]  ramAxiWriteStrobe,    // MMIO registers are word-wide and take no strobe
     output logic [31:0] ramAxiReadAddress,    output logic ramAxiReadValid,      input  logic ramAxiReadReady,
     input  logic [31:0] ramAxiReadData,       input  logic ramAxiReadValidData,  output logic ramAxiReadReadyData,
 
     output logic [31:0] ioAxiWriteAddress,    output logic ioAxiWriteValid,      input  logic ioAxiWriteReady,
     output logic [31:0] ioAxiWriteData,       output logic ioAxiWriteValidData,  input  logic ioAxiWriteReadyData,
     output logic [31:0] ioAxiReadAddress,     output logic ioAxiReadValid,       input  logic ioAxiReadReady,
-    input  logic [31:0] ioAxiReadData,        input  logic ioAxiReadValidData,   output logic ioAxiReadReadyData
+    input  logic [31:0] ioAxiReadData,        input  logic ioAxiReadValidData,   output logic ioAxiReadReadyData,
+
+    // LR/SC RESERVATION (RV32A)
+    input  logic [ID_BITS-1:0] cpuMasterId,   // Hart currently driving the CPU port
+    input  logic        cpuLoadReserve,       // CPU read is LR.W: reserve its word
+    input  logic        cpuStoreConditional,  // CPU write is SC.W: only performed if the reservation holds
+    input  logic [HARTS-1:0] reservationClear, // Trap taken on hart N: drop its reservation
+    output logic        storeConditionalSuccess,
+
+    // PERFORMANCE COUNTERS
+    input  logic        cpuArbitrationLoss,   // A hart wants the CPU port but hart_arbiter granted another
+    input  logic        perfCounterClear,     // Zeroes every counter
+    input  logic [3:0]  perfCounterSelect,    // Counter index (see section 6)
+    output logic [31:0] perfCounterValue
 );
 
     // --- 1. ARBITRATION ---
@@ -44,17 +64,18 @@ module bus_interconnect (
     // --- 2. MASTER MUX ---
     // Routes signals from the active master to the internal bus
     logic [31:0] currAddr_R, currAddr_W, currData_W;
+    logic [3:0]  currStrobe_W;
     logic        currValid_R, currValid_W;
 
     always_comb begin
         if (activeMasterReg == 0) begin // CPU
             currAddr_R  = cpuAxiReadAddress;  currValid_R = cpuAxiReadValid;
             currAddr_W  = cpuAxiWriteAddress; currValid_W = cpuAxiWriteValid;
-            currData_W  = cpuAxiWriteData;
+            currData_W  = cpuAxiWriteData;    currStrobe_W = cpuAxiWriteStrobe;
         end else begin                 // DMA
             currAddr_R  = dmaAxiReadAddress;  currValid_R = dmaAxiReadValid;
             currAddr_W  = dmaAxiWriteAddress; currValid_W = dmaAxiWriteValid;
-            currData_W  = dmaAxiWriteData;
+            currData_W  = dmaAxiWriteData;    currStrobe_W = dmaAxiWriteStrobe;
         end
     end
 
@@ -69,13 +90,13 @@ module bus_interconnect (
         romAxiReadValid  = 0;     ramAxiReadValid  = 0;    ioAxiReadValid  = 0;
 
         // Broadcast current master lines to all slave address/data ports
-        ramAxiWriteAddress = currAddr_W; ramAxiWriteData = currData_W;
+        ramAxiWriteAddress = currAddr_W; ramAxiWriteData = currData_W; ramAxiWriteStrobe = currStrobe_W;
         ioAxiWriteAddress  = currAddr_W; ioAxiWriteData  = currData_W;
         ramAxiReadAddress  = currAddr_R; ioAxiReadAddress = currAddr_R;
         romAxiReadAddress  = currAddr_R;
 
-        // Write Demux (Decoded by Bits [30:29])
-        if (currValid_W) begin
+        // Write Demux (Decoded by Bits [30:29]); a failing SC.W is dropped here
+        if (currValid_W && !storeConditionalDrop) begin
             if (currAddr_W[30])      ioAxiWriteValid  = 1; // MMIO (0x4000_0000)
             else if (currAddr_W[29]) ramAxiWriteValid = 1; // RAM  (0x2000_0000)
         end
@@ -95,7 +116,40 @@ module bus_interconnect (
         end
     end
 
-    // --- 4. STATIC AXI CONTROL FLAGS ---
+    // --- 4. LR/SC RESERVATION ---
+    // One word-granule reservation per hart, set by its LR.W and consumed by
+    // its next SC.W. Any write that lands on the reserved word (DMA, another
+    // hart, or a successful SC) and any trap on the owning hart invalidate it,
+    // so an SC.W only succeeds if nothing else could have touched the word.
+    logic [HARTS-1:0] reservationValid;
+    logic [31:2]      reservationAddress [0:HARTS-1];
+    logic             storeConditionalDrop, writeLands;
+
+    assign storeConditionalSuccess = !activeMasterReg && (int'(cpuMasterId) < HARTS) && reservationValid[cpuMasterId]
+                                     && (reservationAddress[cpuMasterId] == cpuAxiWriteAddress[31:2]);
+    assign storeConditionalDrop    = !activeMasterReg && cpuStoreConditional && !storeConditionalSuccess;
+    assign writeLands              = currValid_W && !storeConditionalDrop;
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            reservationValid <= '0;
+        end else begin
+            for (int hart = 0; hart < HARTS; hart++) begin
+                if (reservationClear[hart])
+                    reservationValid[hart] <= 1'b0;
+                else if (writeLands && currAddr_W[31:2] == reservationAddress[hart])
+                    reservationValid[hart] <= 1'b0;
+                else if (!activeMasterReg && int'(cpuMasterId) == hart && cpuStoreConditional && cpuAxiWriteValid)
+                    reservationValid[hart] <= 1'b0;
+                else if (!activeMasterReg && int'(cpuMasterId) == hart && cpuLoadReserve && cpuAxiReadValid) begin
+                    reservationValid[hart]   <= 1'b1;
+                    reservationAddress[hart] <= cpuAxiReadAddress[31:2];
+                end
+            end
+        end
+    end
+
+    // --- 5. STATIC AXI CONTROL FLAGS ---
     assign cpuAxiReadValidData  = 1'b1;
     assign dmaAxiReadValidData  = 1'b1;
     assign ramAxiWriteValidData = 1'b1;
@@ -104,4 +158,59 @@ module bus_interconnect (
     assign ramAxiReadReadyData  = 1'b1;
     assign ioAxiReadReadyData   = 1'b1;
 
+    // --- 6. PERFORMANCE COUNTERS ---
+    // Transactions are counted per access. LB/LH/SB/SH use fewer than four
+    // byte lanes, so the byte counters add the strobe popcount of each access
+    // (DMA reads are whole words). "Stall" counts cycles a master drives a
+    // request while the other master owns the bus (arbitration loss).
+    // Harts that lose to each other in hart_arbiter never reach the CPU
+    // port, so their waiting cycles are counted separately (HART_STALLS).
+    localparam PERF_CPU_READS   = 0;  localparam PERF_CPU_WRITES = 1;  localparam PERF_CPU_STALLS = 2;
+    localparam PERF_DMA_READS   = 3;  localparam PERF_DMA_WRITES = 4;  localparam PERF_DMA_STALLS = 5;
+    localparam PERF_ROM_READS   = 6;  localparam PERF_RAM_READS  = 7;  localparam PERF_RAM_WRITES = 8;
+    localparam PERF_IO_READS    = 9;  localparam PERF_IO_WRITES  = 10;
+    localparam PERF_BUSY_CYCLES = 11; localparam PERF_CYCLES     = 12; localparam PERF_HART_STALLS = 13;
+    localparam PERF_READ_BYTES  = 14; localparam PERF_WRITE_BYTES = 15;
+    localparam PERF_COUNT       = 16;
+
+    logic [31:0] perfCounters [0:PERF_COUNT-1] /* verilator public_flat */;
+    logic        cpuRequest, dmaRequest;
+    logic [3:0]  currStrobe_R;
+
+    assign cpuRequest   = cpuAxiReadValid || cpuAxiWriteValid;
+    assign dmaRequest   = dmaAxiReadValid || dmaAxiWriteValid;
+    assign currStrobe_R = activeMasterReg ? 4'b1111 : cpuAxiReadStrobe;
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            for (int i = 0; i < PERF_COUNT; i++) perfCounters[i] <= 32'b0;
+        end else if (perfCounterClear) begin
+            for (int i = 0; i < PERF_COUNT; i++) perfCounters[i] <= 32'b0;
+        end else begin
+            // Masters
+            if (!activeMasterReg && cpuAxiReadValid)  perfCounters[PERF_CPU_READS]  <= perfCounters[PERF_CPU_READS]  + 1;
+            if (!activeMasterReg && cpuAxiWriteValid) perfCounters[PERF_CPU_WRITES] <= perfCounters[PERF_CPU_WRITES] + 1;
+            if ( activeMasterReg && cpuRequest)       perfCounters[PERF_CPU_STALLS] <= perfCounters[PERF_CPU_STALLS] + 1;
+            if ( activeMasterReg && dmaAxiReadValid)  perfCounters[PERF_DMA_READS]  <= perfCounters[PERF_DMA_READS]  + 1;
+            if ( activeMasterReg && dmaAxiWriteValid) perfCounters[PERF_DMA_WRITES] <= perfCounters[PERF_DMA_WRITES] + 1;
+            if (!activeMasterReg && dmaRequest)       perfCounters[PERF_DMA_STALLS] <= perfCounters[PERF_DMA_STALLS] + 1;
+            if (cpuArbitrationLoss)                   perfCounters[PERF_HART_STALLS] <= perfCounters[PERF_HART_STALLS] + 1;
+
+            // Slaves
+            if (romAxiReadValid)  perfCounters[PERF_ROM_READS]  <= perfCounters[PERF_ROM_READS]  + 1;
+            if (ramAxiReadValid)  perfCounters[PERF_RAM_READS]  <= perfCounters[PERF_RAM_READS]  + 1;
+            if (ramAxiWriteValid) perfCounters[PERF_RAM_WRITES] <= perfCounters[PERF_RAM_WRITES] + 1;
+            if (ioAxiReadValid)   perfCounters[PERF_IO_READS]   <= perfCounters[PERF_IO_READS]   + 1;
+            if (ioAxiWriteValid)  perfCounters[PERF_IO_WRITES]  <= perfCounters[PERF_IO_WRITES]  + 1;
+
+            if (currValid_R) perfCounters[PERF_READ_BYTES]  <= perfCounters[PERF_READ_BYTES]  + 32'($countones(currStrobe_R));
+            if (writeLands)  perfCounters[PERF_WRITE_BYTES] <= perfCounters[PERF_WRITE_BYTES] + 32'($countones(currStrobe_W));
+
+            if (currValid_R || currValid_W) perfCounters[PERF_BUSY_CYCLES] <= perfCounters[PERF_BUSY_CYCLES] + 1;
+            perfCounters[PERF_CYCLES] <= perfCounters[PERF_CYCLES] + 1;
+        end
+    end
+
+    assign perfCounterValue = (perfCounterSelect < PERF_COUNT) ? perfCounters[perfCounterSelect] : 32'b0;
+
 endmodule
\ No newline at end of file
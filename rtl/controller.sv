@@ -2,17 +2,22 @@ module controller (
     input  logic [6:0] opcode,
     input  logic [2:0] funct3,
     input  logic [6:0] funct7,
-    input  logic       timerInterrupt,      // Preemption signal from hardware timer
+    input  logic [4:0] rs2Field,            // Selects among Zbb unary ops (CLZ/CTZ/CPOP/SEXT/...)
+    input  logic       trapRequest,         // Interrupt taken this cycle (irq_controller, gated by MIE)
 
     output logic       registerWriteEnable, // Enables register file updates
     output logic       aluInputSource,      // 0: reg b, 1: immediate
     output logic       memoryWriteEnable,   // Enables RAM/MMIO writes
     output logic       resultSource,        // 0: ALU result, 1: memory data
     output logic       isBranch,            // High for Jumps/Branches
-    output logic [2:0] aluControlSignal,    // 3-bit opcode for the ALU
+    output logic [4:0] aluControlSignal,    // 5-bit opcode for the ALU
     output logic       csrWriteEnable,      // Captures current PC to MEPC on traps
-    output logic       isTrap,              // High forces jump to 0x00000010
-    output logic       isReturn             // High forces jump to MEPC (MRET)
+    output logic       isTrap,              // High forces jump to the interrupt vector
+    output logic       isReturn,            // High forces jump to MEPC (MRET)
+    output logic       isAtomic,            // RV32A: address is rs1, rd receives the old word
+    output logic       isLoadReserve,       // LR.W: read and reserve
+    output logic       isStoreConditional,  // SC.W: store rs2 if reserved, rd = 0 on success
+    output logic       isCustom             // custom-0/custom-1: rd comes from the accelerator port
 );
 
     logic [1:0] aluOperationCategory;
@@ -29,9 +34,13 @@ module controller (
         csrWriteEnable       = 0;
         isTrap               = 0;
         isReturn             = 0;
+        isAtomic             = 0;
+        isLoadReserve        = 0;
+        isStoreConditional   = 0;
+        isCustom             = 0;
 
-        // Hardware Preemption: Timer takes absolute priority over decoding
-        if (timerInterrupt) begin
+        // Hardware Preemption: an interrupt takes absolute priority over decoding
+        if (trapRequest) begin
             isTrap         = 1;
             csrWriteEnable = 1;
         end else begin
@@ -46,18 +55,39 @@ module controller (
                     aluInputSource       = 1;
                     aluOperationCategory = 2'b10;
                 end
-                7'b0000011: begin // LW
+                7'b0000011: begin // LOAD (LB/LH/LW/LBU/LHU; cpu_core aligns the data)
                     registerWriteEnable  = 1;
                     aluInputSource       = 1;
                     resultSource         = 1;
                 end
-                7'b0100011: begin // SW
+                7'b0100011: begin // STORE (SB/SH/SW; cpu_core sets the byte strobes)
                     memoryWriteEnable    = 1;
                     aluInputSource       = 1;
                 end
-                7'b1100011: begin // BEQ
+                7'b1100011: begin // BRANCH (condition from funct3, compared in cpu_core)
                     isBranch             = 1;
-                    aluOperationCategory = 2'b01; // Force SUB for comparison
+                    aluOperationCategory = 2'b01; // Force SUB
+                end
+                7'b0101111: begin // RV32A (funct3 010: word)
+                    // imm_gen yields 0 for this opcode, so the ALU computes rs1 + 0.
+                    // AMOs read and write the same word in one bus cycle.
+                    isAtomic             = 1;
+                    registerWriteEnable  = 1;
+                    aluInputSource       = 1;
+                    if (funct7[6:2] == 5'b00010) begin        // LR.W
+                        isLoadReserve      = 1;
+                        resultSource       = 1;
+                    end else if (funct7[6:2] == 5'b00011) begin // SC.W
+                        isStoreConditional = 1;
+                        memoryWriteEnable  = 1;
+                    end else begin                              // AMO*.W
+                        resultSource       = 1;
+                        memoryWriteEnable  = 1;
+                    end
+                end
+                7'b0001011, 7'b0101011: begin // CUSTOM-0 / CUSTOM-1 (R-type fields)
+                    registerWriteEnable  = 1;
+                    isCustom             = 1;
                 end
                 7'b1110011: begin // MRET
                     isReturn             = 1;
@@ -66,6 +96,10 @@ module controller (
                     registerWriteEnable  = 1;
                     aluInputSource       = 1;
                 end
+                7'b0010111: begin // AUIPC (cpu_core feeds the PC as operand A)
+                    registerWriteEnable  = 1;
+                    aluInputSource       = 1;
+                end
                 7'b1101111: begin // JAL
                     registerWriteEnable  = 1;
                     isBranch             = 1;
@@ -82,21 +116,67 @@ module controller (
     end
 
     // --- 2. ALU OPERATION DECODER ---
+    // Base ops keep their original codes (0-5), with SLTU and the shifts at
+    // 26-29; Zba/Zbb ops are selected by funct7 (and the rs2 field for the
+    // unary forms) on top of funct3.
+    logic isRegister;
+    assign isRegister = (opcode == 7'b0110011);
+
     always_comb begin
         case (aluOperationCategory)
-            2'b00: aluControlSignal = 3'b000; // Force ADD
-            2'b01: aluControlSignal = 3'b001; // Force SUB
+            2'b00: aluControlSignal = 5'd0; // Force ADD
+            2'b01: aluControlSignal = 5'd1; // Force SUB
             2'b10: begin 
                 case (funct3)
-                    3'b000:  aluControlSignal = (opcode == 7'b0110011 && funct7[5]) ? 3'b001 : 3'b000;
-                    3'b010:  aluControlSignal = 3'b101; // SLT
-                    3'b110:  aluControlSignal = 3'b011; // OR 
-                    3'b111:  aluControlSignal = 3'b010; // AND
-                    3'b100:  aluControlSignal = 3'b100; // XOR
-                    default: aluControlSignal = 3'b000;
+                    3'b000:  aluControlSignal = (isRegister && funct7[5]) ? 5'd1 : 5'd0;
+                    3'b001: begin
+                        if (funct7 == 7'b0110000 && isRegister) aluControlSignal = 5'd12; // ROL
+                        else if (funct7 == 7'b0110000) begin                                // Unary (I-type)
+                            case (rs2Field)
+                                5'b00000: aluControlSignal = 5'd9;  // CLZ
+                                5'b00001: aluControlSignal = 5'd10; // CTZ
+                                5'b00010: aluControlSignal = 5'd11; // CPOP
+                                5'b00100: aluControlSignal = 5'd23; // SEXT.B
+                                5'b00101: aluControlSignal = 5'd24; // SEXT.H
+                                default:  aluControlSignal = 5'd0;
+                            endcase
+                        end
+                        else if (funct7 == 7'b0000000) aluControlSignal = 5'd27; // SLL / SLLI
+                        else aluControlSignal = 5'd0;
+                    end
+                    3'b010:  aluControlSignal = (isRegister && funct7 == 7'b0010000) ? 5'd18 : 5'd5; // SH1ADD / SLT
+                    3'b011:  aluControlSignal = 5'd26;                                               // SLTU / SLTIU
+                    3'b100: begin
+                        if      (isRegister && funct7 == 7'b0100000) aluControlSignal = 5'd8;  // XNOR
+                        else if (isRegister && funct7 == 7'b0000101) aluControlSignal = 5'd14; // MIN
+                        else if (isRegister && funct7 == 7'b0000100) aluControlSignal = 5'd25; // ZEXT.H
+                        else if (isRegister && funct7 == 7'b0010000) aluControlSignal = 5'd19; // SH2ADD
+                        else                                         aluControlSignal = 5'd4;  // XOR
+                    end
+                    3'b101: begin
+                        if      (isRegister && funct7 == 7'b0000101)         aluControlSignal = 5'd16; // MINU
+                        else if (funct7 == 7'b0110000)                       aluControlSignal = 5'd13; // ROR / RORI
+                        else if (!isRegister && funct7 == 7'b0110100 && rs2Field == 5'b11000) aluControlSignal = 5'd21; // REV8
+                        else if (!isRegister && funct7 == 7'b0010100 && rs2Field == 5'b00111) aluControlSignal = 5'd22; // ORC.B
+                        else if (funct7 == 7'b0000000)                       aluControlSignal = 5'd28; // SRL / SRLI
+                        else if (funct7 == 7'b0100000)                       aluControlSignal = 5'd29; // SRA / SRAI
+                        else                                                 aluControlSignal = 5'd0;
+                    end
+                    3'b110: begin
+                        if      (isRegister && funct7 == 7'b0100000) aluControlSignal = 5'd7;  // ORN
+                        else if (isRegister && funct7 == 7'b0000101) aluControlSignal = 5'd15; // MAX
+                        else if (isRegister && funct7 == 7'b0010000) aluControlSignal = 5'd20; // SH3ADD
+                        else                                         aluControlSignal = 5'd3;  // OR
+                    end
+                    3'b111: begin
+                        if      (isRegister && funct7 == 7'b0100000) aluControlSignal = 5'd6;  // ANDN
+                        else if (isRegister && funct7 == 7'b0000101) aluControlSignal = 5'd17; // MAXU
+                        else                                         aluControlSignal = 5'd2;  // AND
+                    end
+                    default: aluControlSignal = 5'd0;
                 endcase
             end
-            default: aluControlSignal = 3'b000;
+            default: aluControlSignal = 5'd0;
         endcase
     end
 
@@ -0,0 +1,236 @@
+module cpu_core #(
+    parameter HART_ID          = 0, // Value read back from MHARTID (0x40000014)
+    parameter MEMORY_SYNC_READ = 0  // 1: ROM/RAM reads are registered (see soc_top)
+) (
+    input  logic        clock,
+    input  logic        resetActiveLow,
+
+    // Interrupt Requests
+    input  logic        interruptRequest,        // Level from the hart's irq_controller
+    input  logic [31:0] interruptVector,         // Trap target for the requesting source
+
+    // Instruction Fetch
+    output logic [31:0] programCounter,
+    output logic [31:0] fetchAddress,            // PC being loaded this edge (for a registered ROM)
+    input  logic [31:0] fetchWindow,             // 32 bits starting at the PC (halfword aligned)
+    output logic [31:0] instruction,             // Executing instruction, compressed forms expanded
+    input  logic        fetchReady,              // Low while the fetch source is still filling
+    output logic        coreStall,
+
+    // Data Bus Master
+    output logic        dataRequest,             // Unqualified access request, for arbitration
+    input  logic        dataGrant,               // Bus owned this cycle (tie high with a single master)
+    output logic [31:0] dataAddress,
+    output logic        dataReadValid,
+    output logic        dataWriteValid,
+    output logic [31:0] dataWriteData,           // Shifted into its byte lanes for SB/SH
+    output logic [3:0]  dataStrobe,              // Byte lanes loaded or stored (1111 for LW/SW and RV32A)
+    input  logic [31:0] dataReadData,
+    output logic        loadReserve,             // LR.W in flight
+    output logic        storeConditional,        // SC.W in flight
+    input  logic        storeConditionalSuccess,
+    output logic        trapTaken,               // Trap entry this cycle (drops the LR/SC reservation)
+    output logic [31:0] mepcValue,
+
+    // Accelerator Port (custom-0 / custom-1, R-type fields)
+    output logic        accelValid,              // Held until accelReady; dropped if a trap cancels it
+    output logic        accelCustom1,            // 0: custom-0, 1: custom-1
+    output logic [2:0]  accelFunct3,
+    output logic [6:0]  accelFunct7,
+    output logic [31:0] accelOperandA,           // rs1
+    output logic [31:0] accelOperandB,           // rs2
+    input  logic [31:0] accelResult,             // Written to rd on the edge where accelReady is high
+    input  logic        accelReady,              // Tie high for single-cycle units
+
+    // Retire Port (simulation monitors; leave unconnected otherwise)
+    output logic        retireValid,             // The instruction commits on this edge
+    output logic        retireRegisterWrite,     // ... and writes rd (instruction[11:7])
+    output logic [31:0] retireRegisterData       // Value written to rd
+);
+
+    // --- 1. INTERRUPT ENTRY ---
+    // The irq_controller decides which source may interrupt (priority above
+    // any running handler); MSTATUS.MIE decides when. Entry clears MIE, so
+    // MEPC is never overwritten until the handler has saved it and set MIE
+    // again to allow nesting.
+    logic [31:0] mstatusValue;
+    logic        trapRequest;
+
+    assign trapRequest = interruptRequest && mstatusValue[3];
+    assign trapTaken   = trapRequest;
+
+    // --- 2. INSTRUCTION FETCH & PC LOGIC ---
+    logic [31:0] nextProgramCounter, immediateValue, instructionLength;
+    logic        isTrap, isReturn, isBranch, branchTaken, isCompressed, isCustom;
+
+    // RV32C: 16-bit encodings are expanded before decode; the PC then
+    // advances (and JAL/JALR link) by 2 instead of 4.
+    rvc_expander u_rvc (
+        .fetchWindow(fetchWindow), .instruction(instruction),
+        .isCompressed(isCompressed), .isIllegal()
+    );
+    assign instructionLength = isCompressed ? 32'd2 : 32'd4;
+
+    // Stall: the current instruction is not ready to commit (fetch miss, the
+    // first cycle of a load from registered memory, bus lost to another hart,
+    // or an accelerator still working).
+    // A trap may still redirect the PC; MEPC then holds the stalled PC.
+    logic        loadStall, loadDataPhase, pcEnable;
+    assign coreStall = !fetchReady || loadStall || (dataRequest && !dataGrant) || (isCustom && !accelReady);
+    assign pcEnable  = !coreStall || trapRequest;
+
+    // Registered reads return data one cycle after the address: a load spends
+    // its first cycle presenting the address and commits in the second.
+    // A trap in the first cycle abandons the load, so the data phase must not
+    // carry over to the handler's first instruction.
+    assign loadStall = MEMORY_SYNC_READ && resultSource && !loadDataPhase;
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) loadDataPhase <= 1'b0;
+        else                 loadDataPhase <= loadStall && fetchReady && dataGrant && !trapRequest;
+    end
+
+    // Branch condition from funct3, compared on the register operands
+    // (010/011 are reserved and never taken)
+    always_comb begin
+        case (instruction[14:12])
+            3'b000:  branchTaken = (readData1 == readData2);                   // BEQ
+            3'b001:  branchTaken = (readData1 != readData2);                   // BNE
+            3'b100:  branchTaken = ($signed(readData1) <  $signed(readData2)); // BLT
+            3'b101:  branchTaken = ($signed(readData1) >= $signed(readData2)); // BGE
+            3'b110:  branchTaken = (readData1 <  readData2);                   // BLTU
+            3'b111:  branchTaken = (readData1 >= readData2);                   // BGEU
+            default: branchTaken = 1'b0;
+        endcase
+    end
+
+    assign nextProgramCounter =
+        (isTrap || trapRequest)         ? interruptVector :
+        isReturn                        ? mepcValue    :
+        (isBranch && (instruction[6:0] == 7'b1100111)) ? {aluResult[31:1], 1'b0} :
+        (isBranch && (branchTaken || (instruction[6:0] == 7'b1101111))) ? (programCounter + immediateValue) :
+                                          (programCounter + instructionLength);
+
+    pc_reg u_pc (
+        .clock(clock), .resetActiveLow(resetActiveLow), .enable(pcEnable),
+        .nextProgramCounter(nextProgramCounter), .programCounter(programCounter)
+    );
+
+    // A registered ROM is addressed with the PC being loaded this edge, so the
+    // instruction word arrives together with the new PC (no fetch bubble).
+    assign fetchAddress = !MEMORY_SYNC_READ ? programCounter      :
+                          !resetActiveLow   ? 32'b0               :
+                          pcEnable          ? nextProgramCounter  : programCounter;
+
+    // --- 3. CORE DATAPATH & CONTROL ---
+    logic [31:0] readData1, readData2, aluResult, busReadData, alignedReadData;
+    logic [4:0]  aluControl;
+    logic        registerWriteEnable, memoryWriteEnable, aluInputSource, resultSource, csrWriteEnable;
+    logic        isAtomic, isLoadReserve, isStoreConditional;
+    logic [31:0] amoStoreValue;
+
+    controller u_ctrl (
+        .opcode(instruction[6:0]), .funct3(instruction[14:12]), .funct7(instruction[31:25]),
+        .rs2Field(instruction[24:20]),
+        .trapRequest(trapRequest), .registerWriteEnable(registerWriteEnable),
+        .aluInputSource(aluInputSource), .memoryWriteEnable(memoryWriteEnable),
+        .resultSource(resultSource), .isBranch(isBranch), .aluControlSignal(aluControl),
+        .csrWriteEnable(csrWriteEnable), .isTrap(isTrap), .isReturn(isReturn),
+        .isAtomic(isAtomic), .isLoadReserve(isLoadReserve), .isStoreConditional(isStoreConditional),
+        .isCustom(isCustom)
+    );
+
+    // Sub-word loads: the bus returns the whole word; pick the addressed
+    // lane and extend it (funct3[2] selects zero extension)
+    logic [31:0] loadShifted;
+    assign loadShifted = busReadData >> {aluResult[1:0], 3'b0};
+
+    always_comb begin
+        alignedReadData = busReadData;
+        if (instruction[6:0] == 7'b0000011) begin
+            case (instruction[14:12])
+                3'b000:  alignedReadData = {{24{loadShifted[7]}}, loadShifted[7:0]};   // LB
+                3'b001:  alignedReadData = {{16{loadShifted[15]}}, loadShifted[15:0]}; // LH
+                3'b100:  alignedReadData = {24'b0, loadShifted[7:0]};                 // LBU
+                3'b101:  alignedReadData = {16'b0, loadShifted[15:0]};                // LHU
+                default: alignedReadData = busReadData;                               // LW
+            endcase
+        end
+    end
+
+    logic [31:0] writeBackData;
+    assign writeBackData = isCustom ? accelResult :
+                           isStoreConditional ? {31'b0, !storeConditionalSuccess} :
+                           resultSource ? alignedReadData : ((instruction[6:0] == 7'b1101111 || instruction[6:0] == 7'b1100111) ? (programCounter + instructionLength) : aluResult);
+
+    regfile u_rf (
+        .clock(clock), .registerWriteEnable(registerWriteEnable && !coreStall),
+        .readAddress0(instruction[19:15]), .readAddress1(instruction[24:20]),
+        .writeAddress(instruction[11:7]),
+        .writeData(writeBackData),
+        .readData0(readData1), .readData1(readData2)
+    );
+
+    // A taken trap replaces the instruction (the controller drops its
+    // register write), so it does not retire
+    assign retireValid         = !coreStall && !trapRequest;
+    assign retireRegisterWrite = registerWriteEnable && !coreStall && instruction[11:7] != 5'd0;
+    assign retireRegisterData  = writeBackData;
+
+    alu u_alu (
+        .inputA((instruction[6:0] == 7'b0110111) ? 32'b0 :
+                (instruction[6:0] == 7'b0010111) ? programCounter : readData1), // LUI / AUIPC
+        .inputB(aluInputSource ? immediateValue : readData2),
+        .aluControl(aluControl), .aluResult(aluResult), .zero()
+    );
+
+    // AMO*.W: the old word comes back on the read channel and the combined
+    // value goes out on the write channel in the same bus cycle.
+    amo_unit u_amo (
+        .amoFunct5(instruction[31:27]), .memoryValue(busReadData),
+        .operandValue(readData2), .storeValue(amoStoreValue)
+    );
+
+    imm_gen u_imm_gen (.instruction(instruction), .immediateValue(immediateValue));
+
+    // --- 4. DATA BUS MASTER ---
+    assign dataRequest      = memoryWriteEnable || resultSource;
+    assign dataAddress      = aluResult;
+    assign dataReadValid    = resultSource && !coreStall;
+    assign dataWriteValid   = memoryWriteEnable && !coreStall;
+    assign dataWriteData    = (isAtomic && !isStoreConditional) ? amoStoreValue :
+                              (isAtomic || instruction[13])     ? readData2     :
+                                                                  (readData2 << {aluResult[1:0], 3'b0}); // SB/SH
+    assign dataStrobe       = (isAtomic || instruction[13])  ? 4'b1111 :                       // LW/SW, RV32A
+                              instruction[12]                ? (4'b0011 << aluResult[1:0]) :   // LH(U)/SH
+                                                               (4'b0001 << aluResult[1:0]);    // LB(U)/SB
+    assign loadReserve      = isLoadReserve;
+    assign storeConditional = isStoreConditional;
+
+    // --- 5. ACCELERATOR PORT ---
+    // Operands come straight from the register file; the instruction stalls
+    // in place until the unit answers, so a multi-cycle unit sees stable inputs.
+    assign accelValid    = isCustom && fetchReady;
+    assign accelCustom1  = instruction[5];
+    assign accelFunct3   = instruction[14:12];
+    assign accelFunct7   = instruction[31:25];
+    assign accelOperandA = readData1;
+    assign accelOperandB = readData2;
+
+    // --- 6. HART-LOCAL CSR WINDOW ---
+    // MEPC (0x40000010), MHARTID (0x40000014) and MSTATUS (0x40000020) belong
+    // to this hart; reads are answered here, whatever the shared bus returns.
+    assign busReadData = (aluResult == 32'h40000010) ? mepcValue      :
+                         (aluResult == 32'h40000014) ? 32'(HART_ID)   :
+                         (aluResult == 32'h40000020) ? mstatusValue   : dataReadData;
+
+    csr_unit u_csr (
+        .clock(clock), .resetActiveLow(resetActiveLow),
+        .csrWriteEnable(csrWriteEnable), .pcFromCore(programCounter),
+        .busWriteEnable((dataWriteValid && (aluResult == 32'h40000010)) || trapRequest),
+        .busWriteData(trapRequest ? programCounter : dataWriteData),
+        .trapEnter(trapRequest), .trapReturn(isReturn && !coreStall),
+        .mstatusWriteEnable(dataWriteValid && (aluResult == 32'h40000020)),
+        .mstatusValue(mstatusValue), .mepcValue(mepcValue)
+    );
+
+endmodule
@@ -9,6 +9,12 @@ module csr_unit (
     // Software Bus Interface (MMIO: 0x40000010)
     input  logic        busWriteEnable, // Write request from Bus Interconnect
     input  logic [31:0] busWriteData,   // Data from Bus Interconnect
+
+    // MSTATUS (MMIO: 0x40000020): interrupt enable stack
+    input  logic        trapEnter,          // Trap taken: MPIE <= MIE, MIE <= 0
+    input  logic        trapReturn,         // MRET committed: MIE <= MPIE, MPIE <= 1
+    input  logic        mstatusWriteEnable, // Software write (data on busWriteData)
+    output logic [31:0] mstatusValue,       // MIE at bit 3, MPIE at bit 7 (RISC-V layout)
     
     // Output to Program Counter Logic
     output logic [31:0] mepcValue       // Value stored in MEPC register
@@ -31,7 +37,33 @@ module csr_unit (
         end
     end
 
+    // MSTATUS Register Logic
+    // MIE resets to 1 so firmware that never touches MSTATUS is still preempted
+    logic mie, mpie;
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            mie  <= 1'b1;
+            mpie <= 1'b1;
+        end
+        // ENTRY: a handler starts with interrupts off until it re-enables them
+        else if (trapEnter) begin
+            mpie <= mie;
+            mie  <= 1'b0;
+        end
+        // MRET: restore the interrupted context's enable
+        else if (trapReturn) begin
+            mie  <= mpie;
+            mpie <= 1'b1;
+        end
+        else if (mstatusWriteEnable) begin
+            mie  <= busWriteData[3];
+            mpie <= busWriteData[7];
+        end
+    end
+
     // Continuous assignment to output
-    assign mepcValue = mepc;
+    assign mepcValue    = mepc;
+    assign mstatusValue = {24'b0, mpie, 3'b0, mie, 3'b0};
 
 endmodule
\ No newline at end of file
@@ -1,9 +1,13 @@
-module data_mem (
+module data_mem #(
+    parameter syncRead = 0,   // 1: registered reads (block-RAM inferable), data valid one cycle after the address
+    parameter ramWords = 1024 // Depth in 32-bit words (power of two)
+) (
     input  logic        clock,
     
     // Write Interface (AXI-lite compatible)
     input  logic [31:0] ramAxiWriteAddress, // Byte-address for memory write 
     input  logic [31:0] ramAxiWriteData,    // 32-bit word to be stored 
+    input  logic [3:0]  ramAxiWriteStrobe,  // Byte lanes to update (SB/SH write one or two)
     input  logic        ramAxiWriteValid,   // Write strobe from bus interconnect 
     
     // Read Interface
@@ -11,18 +15,31 @@ module data_mem (
     output logic [31:0] ramAxiReadData      // 32-bit word output to bus 
 );
 
-    // 4KB RAM: 1024 words of 32 bits each 
-    logic [31:0] ramArray [0:1023];
+    // 4KB RAM by default: ramWords words of 32 bits each
+    localparam indexBits = $clog2(ramWords);
+    logic [31:0] ramArray [0:ramWords-1] /* verilator public_flat */;
 
     // Synchronous Write Logic: Updates RAM on the positive clock edge 
     always_ff @(posedge clock) begin
         if (ramAxiWriteValid) begin
-            // Address bits [11:2] select the word index (stripping byte-offset) 
-            ramArray[ramAxiWriteAddress[11:2]] <= ramAxiWriteData;
+            // Address bits [indexBits+1:2] select the word index (stripping byte-offset) 
+            for (int lane = 0; lane < 4; lane++) begin
+                if (ramAxiWriteStrobe[lane])
+                    ramArray[ramAxiWriteAddress[indexBits+1:2]][lane*8 +: 8] <= ramAxiWriteData[lane*8 +: 8];
+            end
         end
     end
 
-    // Asynchronous Read Logic: Provides immediate data based on address 
-    assign ramAxiReadData = ramArray[ramAxiReadAddress[11:2]];
+    generate
+        if (syncRead) begin : gen_sync_read
+            // Synchronous Read Logic: Data for the address presented this cycle appears after the edge
+            always_ff @(posedge clock) begin
+                ramAxiReadData <= ramArray[ramAxiReadAddress[indexBits+1:2]];
+            end
+        end else begin : gen_async_read
+            // Asynchronous Read Logic: Provides immediate data based on address 
+            assign ramAxiReadData = ramArray[ramAxiReadAddress[indexBits+1:2]];
+        end
+    endgenerate
 
 endmodule
\ No newline at end of file
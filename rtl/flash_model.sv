@@ -0,0 +1,68 @@
+module flash_model #(
+    parameter flashWords       = 16384, // 64KB execute-in-place flash
+    parameter lineWords        = 4,     // Words returned per line read
+    parameter firstWordLatency = 8      // Cycles until the first word (command + address + dummy)
+) (
+    input  logic                      clock,
+    input  logic                      resetActiveLow,
+
+    // Line Read Port (Instruction Cache refill)
+    input  logic                      lineRequestValid,   // Start a line read (ignored while busy)
+    input  logic [31:0]               lineRequestAddress, // Any byte address inside the line
+    output logic                      lineRequestReady,   // High when no read is in flight
+    output logic                      lineResponseValid,  // Single-cycle pulse with the full line
+    output logic [lineWords*32-1:0]   lineResponseData,   // Word 0 in bits [31:0]
+
+    // Data Bus Read Port (ROM constants; modelled as a memory-mapped read)
+    input  logic [31:0]               busReadAddress,
+    output logic [31:0]               busReadData
+);
+
+    localparam indexBits   = $clog2(flashWords);
+    localparam offsetBits  = $clog2(lineWords);
+    // One word per cycle after the first: total line time
+    localparam lineLatency = firstWordLatency + lineWords - 1;
+
+    logic [31:0] flashArray [0:flashWords-1];
+
+    // Initialize flash from the same image the ROM uses
+    initial begin
+        $readmemh("firmware/firmware.hex", flashArray);
+    end
+
+    logic        busy;
+    logic [15:0] countdown;
+    logic [indexBits-1:0] lineBaseIndex;
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            busy              <= 1'b0;
+            countdown         <= 16'b0;
+            lineResponseValid <= 1'b0;
+        end else begin
+            lineResponseValid <= 1'b0;
+            if (!busy && lineRequestValid) begin
+                // Align to the start of the line
+                busy          <= 1'b1;
+                countdown     <= lineLatency - 1;
+                lineBaseIndex <= lineRequestAddress[indexBits+1:2] & ~(indexBits'(lineWords - 1));
+            end else if (busy) begin
+                if (countdown == 0) begin
+                    busy              <= 1'b0;
+                    lineResponseValid <= 1'b1;
+                    for (int i = 0; i < lineWords; i++) begin
+                        lineResponseData[i*32 +: 32] <= flashArray[lineBaseIndex + indexBits'(i)];
+                    end
+                end else begin
+                    countdown <= countdown - 1;
+                end
+            end
+        end
+    end
+
+    assign lineRequestReady = !busy;
+
+    // Port B Read: constants are served without modelling the flash latency
+    assign busReadData = flashArray[busReadAddress[indexBits+1:2]];
+
+endmodule
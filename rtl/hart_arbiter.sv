@@ -0,0 +1,35 @@
+module hart_arbiter #(
+    parameter HARTS   = 2,
+    parameter ID_BITS = (HARTS > 1) ? $clog2(HARTS) : 1
+) (
+    input  logic                clock,
+    input  logic                resetActiveLow,
+
+    input  logic [HARTS-1:0]    request,      // One bit per hart: access wanted this cycle
+    output logic [HARTS-1:0]    grant,        // One-hot (or zero when nobody requests)
+    output logic [ID_BITS-1:0]  grantedHart   // Index of the granted hart (0 when idle)
+);
+
+    // Round-robin: the search starts at the hart after the last one granted,
+    // so a hart that keeps requesting waits at most HARTS-1 cycles.
+    logic [ID_BITS-1:0] lastGranted;
+
+    always_comb begin
+        grant       = '0;
+        grantedHart = '0;
+        for (int offset = 1; offset <= HARTS; offset++) begin
+            int candidate;
+            candidate = (int'(lastGranted) + offset) % HARTS;
+            if (grant == '0 && request[candidate]) begin
+                grant[candidate] = 1'b1;
+                grantedHart      = ID_BITS'(candidate);
+            end
+        end
+    end
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow)  lastGranted <= ID_BITS'(HARTS - 1); // Hart 0 wins the first tie
+        else if (|request)    lastGranted <= grantedHart;
+    end
+
+endmodule
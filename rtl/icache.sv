@@ -0,0 +1,112 @@
+module icache #(
+    parameter ways      = 2,  // 1: direct-mapped, 2: two-way set associative (LRU)
+    parameter sets      = 16,
+    parameter lineWords = 4
+) (
+    input  logic                      clock,
+    input  logic                      resetActiveLow,
+
+    // Core Fetch Port
+    input  logic [31:0]               fetchAddress,
+    input  logic                      fetchEnable,        // Core consumes the instruction this cycle
+    output logic [31:0]               fetchData,
+    output logic                      fetchReady,         // Low while the line is being refilled
+
+    // Refill Port (to flash_model)
+    output logic                      lineRequestValid,
+    output logic [31:0]               lineRequestAddress,
+    input  logic                      lineRequestReady,
+    input  logic                      lineResponseValid,
+    input  logic [lineWords*32-1:0]   lineResponseData,
+
+    // Statistics
+    output logic [31:0]               hitCount,           // Instructions delivered from the cache (a miss is delivered after its refill)
+    output logic [31:0]               missCount,          // Line refills started
+    output logic [31:0]               stallCycles         // Cycles the core waited on a refill
+);
+
+    localparam offsetBits = $clog2(lineWords);
+    localparam indexBits  = $clog2(sets);
+    localparam tagBits    = 32 - 2 - offsetBits - indexBits;
+
+    // --- 1. STORAGE ---
+    logic [lineWords*32-1:0] dataArray  [0:ways-1][0:sets-1];
+    logic [tagBits-1:0]      tagArray   [0:ways-1][0:sets-1];
+    logic                    validArray [0:ways-1][0:sets-1];
+    logic                    lruWay     [0:sets-1];           // Way to replace next (2-way only)
+
+    // --- 2. LOOKUP ---
+    logic [offsetBits-1:0] fetchOffset;
+    logic [indexBits-1:0]  fetchIndex;
+    logic [tagBits-1:0]    fetchTag;
+    logic                  hit;
+    logic                  hitWay;
+
+    assign fetchOffset = fetchAddress[offsetBits+1:2];
+    assign fetchIndex  = fetchAddress[offsetBits+indexBits+1:offsetBits+2];
+    assign fetchTag    = fetchAddress[31:offsetBits+indexBits+2];
+
+    always_comb begin
+        hit       = 1'b0;
+        hitWay    = 1'b0;
+        fetchData = 32'b0;
+        for (int w = 0; w < ways; w++) begin
+            if (validArray[w][fetchIndex] && tagArray[w][fetchIndex] == fetchTag) begin
+                hit       = 1'b1;
+                hitWay    = w[0];
+                fetchData = dataArray[w][fetchIndex][fetchOffset*32 +: 32];
+            end
+        end
+    end
+
+    assign fetchReady = hit;
+
+    // --- 3. REFILL STATE MACHINE ---
+    // One refill in flight. If the PC is redirected mid-refill the line is
+    // still installed, then the new address is looked up.
+    logic                 refilling;
+    logic [31:0]          refillAddress;
+    logic [indexBits-1:0] refillIndex;
+    logic [tagBits-1:0]   refillTag;
+    logic                 victimWay;
+
+    assign refillIndex = refillAddress[offsetBits+indexBits+1:offsetBits+2];
+    assign refillTag   = refillAddress[31:offsetBits+indexBits+2];
+    assign victimWay   = (ways == 1) ? 1'b0 : lruWay[refillIndex];
+
+    assign lineRequestValid   = !refilling && !hit && resetActiveLow;
+    assign lineRequestAddress = fetchAddress;
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            refilling   <= 1'b0;
+            hitCount    <= 32'b0;
+            missCount   <= 32'b0;
+            stallCycles <= 32'b0;
+            for (int s = 0; s < sets; s++) begin
+                lruWay[s] <= 1'b0;
+                for (int w = 0; w < ways; w++) validArray[w][s] <= 1'b0;
+            end
+        end else begin
+            if (!hit) stallCycles <= stallCycles + 1;
+
+            if (hit && fetchEnable) begin
+                hitCount           <= hitCount + 1;
+                lruWay[fetchIndex] <= ~hitWay;
+            end
+
+            if (lineRequestValid && lineRequestReady) begin
+                refilling     <= 1'b1;
+                refillAddress <= fetchAddress;
+                missCount     <= missCount + 1;
+            end else if (refilling && lineResponseValid) begin
+                refilling                         <= 1'b0;
+                dataArray[victimWay][refillIndex]  <= lineResponseData;
+                tagArray[victimWay][refillIndex]   <= refillTag;
+                validArray[victimWay][refillIndex] <= 1'b1;
+                lruWay[refillIndex]                <= ~victimWay;
+            end
+        end
+    end
+
+endmodule
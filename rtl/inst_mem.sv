@@ -1,5 +1,12 @@
-module inst_mem (
+module inst_mem #(
+    parameter syncRead = 0,   // 1: registered reads (block-RAM inferable), data valid one cycle after the address
+    parameter romWords = 1024 // Depth in 32-bit words (power of two)
+) (
+    input  logic        clock,             // Used only when syncRead = 1
+
     // Port A: Instruction Fetch (Dedicated for CPU core)
+    // Halfword aligned: returns the 32 bits starting at the address, so a
+    // 32-bit instruction after a compressed one may straddle two words.
     input  logic [31:0] romAxiReadAddress, 
     output logic [31:0] romAxiReadData,
     
@@ -8,18 +15,65 @@ module inst_mem (
     output logic [31:0] busReadData
 );
 
-    // 4KB ROM: 1024 words (32-bit each) 
-    logic [31:0] romArray [0:1023];
+    // 4KB ROM by default: romWords words (32-bit each), interleaved over two
+    // banks by word-index bit 0. The fetch window needs a word and its
+    // successor, which always sit in different banks, so each bank sees one
+    // fetch read per cycle (plus the bus port).
+    localparam indexBits = $clog2(romWords);
+    localparam bankWords = romWords / 2;
+    logic [31:0] romEven [0:bankWords-1] /* verilator public_flat */; // Words 0, 2, 4, ...
+    logic [31:0] romOdd  [0:bankWords-1] /* verilator public_flat */; // Words 1, 3, 5, ...
+    logic [31:0] romImage [0:romWords-1];
 
-    // Initialize memory from hex file at startup 
+    // Initialize memory from hex file at startup, then deal the words out to the banks
     initial begin
-        $readmemh("firmware/firmware.hex", romArray);
+        $readmemh("firmware/firmware.hex", romImage);
+        for (int index = 0; index < bankWords; index++) begin
+            romEven[index] = romImage[2 * index];
+            romOdd[index]  = romImage[2 * index + 1];
+        end
     end
 
-    // Port A Read: Word-aligned indexing using address bits [11:2]
-    assign romAxiReadData = romArray[romAxiReadAddress[11:2]];
+    // Fetch window: the addressed word and its successor (wraps at the top).
+    // For an odd word the successor is the next even one.
+    logic [indexBits-1:0] fetchIndex, busIndex;
+    logic [indexBits-2:0] evenIndex, oddIndex;
+    logic [31:0]          evenWord, oddWord;
+    assign fetchIndex = romAxiReadAddress[indexBits+1:2];
+    assign busIndex   = busReadAddress[indexBits+1:2];
+    assign oddIndex   = fetchIndex[indexBits-1:1];
+    assign evenIndex  = fetchIndex[indexBits-1:1] + (indexBits-1)'(fetchIndex[0]);
+
+    generate
+        if (syncRead) begin : gen_sync_read
+            // Registered Reads: one fetch read per bank and the bus port, sampled on the edge
+            logic fetchOdd, fetchHalf;
+            always_ff @(posedge clock) begin
+                evenWord    <= romEven[evenIndex];
+                oddWord     <= romOdd[oddIndex];
+                fetchOdd    <= fetchIndex[0];
+                fetchHalf   <= romAxiReadAddress[1];
+                busReadData <= busIndex[0] ? romOdd[busIndex[indexBits-1:1]] : romEven[busIndex[indexBits-1:1]];
+            end
+            assign romAxiReadData = assembleWindow(evenWord, oddWord, fetchOdd, fetchHalf);
+        end else begin : gen_async_read
+            // Port A Read: word index from address bits [indexBits+1:2], upper half first when bit 1 is set
+            assign evenWord       = romEven[evenIndex];
+            assign oddWord        = romOdd[oddIndex];
+            assign romAxiReadData = assembleWindow(evenWord, oddWord, fetchIndex[0], romAxiReadAddress[1]);
     
-    // Port B Read: Enables "Von Neumann access" to ROM data 
-    assign busReadData    = romArray[busReadAddress[11:2]];
+            // Port B Read: Enables "Von Neumann access" to ROM data 
+            assign busReadData    = busIndex[0] ? romOdd[busIndex[indexBits-1:1]] : romEven[busIndex[indexBits-1:1]];
+        end
+    endgenerate
+
+    // Orders the two bank words into (addressed word, successor) and picks the halfword-aligned window
+    function automatic logic [31:0] assembleWindow(input logic [31:0] even, input logic [31:0] odd,
+                                                   input logic wordOdd, input logic upperHalf);
+        logic [31:0] low, high;
+        low  = wordOdd ? odd  : even;
+        high = wordOdd ? even : odd;
+        return upperHalf ? {high[15:0], low[31:16]} : low;
+    endfunction
 
-endmodule
\ No newline at end of file
+endmodule
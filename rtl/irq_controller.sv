@@ -0,0 +1,129 @@
+module irq_controller #(
+    parameter sources     = 4,          // Source IDs 1..sources (at most 7); ID 0 means "none"
+    parameter bootSources = 8'b00000000 // Bit per ID: enabled at priority 1 out of reset
+) (
+    input  logic               clock,
+    input  logic               resetActiveLow,
+
+    // Sources: a rising edge latches the pending bit (edge-triggered gateway)
+    input  logic [sources:1]   sourceLevel,
+
+    // Register window (hart-local, MMIO 0x40000400 + offset)
+    input  logic [7:0]         registerOffset,
+    input  logic               registerWriteValid,
+    input  logic [31:0]        registerWriteData,
+    output logic [31:0]        registerReadData,
+
+    // Core Interface
+    output logic               interruptRequest,  // Best source outranks the threshold and every running handler
+    output logic [31:0]        interruptVector,   // MTVEC base, + 4 * ID in vectored mode
+    input  logic               trapTaken          // The core took the trap: claim the best source
+);
+
+    // Register offsets
+    localparam regPending   = 8'h00; // R: pending bits, W: 1s raise sources (software trigger)
+    localparam regEnable    = 8'h04; // RW: enable bits
+    localparam regThreshold = 8'h08; // RW: only priorities above this interrupt
+    localparam regClaim     = 8'h0C; // R: ID claimed at the latest trap entry, W: complete ID
+    localparam regMtvec     = 8'h10; // RW: trap base, bit 0 selects vectored mode
+    localparam regActive    = 8'h14; // R: claimed and not yet completed
+    localparam regPriority  = 8'h20; // RW: +4*ID, 0 = never, 7 = highest
+
+    // Bit 0 of every mask is unused so bit N belongs to source ID N
+    logic [sources:0] pending, enable, active, sourcePrevious, sourceRise;
+    logic [2:0]       sourcePriority [1:sources];
+    logic [2:0]       threshold;
+    logic [31:0]      mtvec;
+    logic [2:0]       claimedId;
+
+    assign sourceRise = {sourceLevel, 1'b0} & ~sourcePrevious;
+
+    // --- 1. ARBITRATION ---
+    // The best source is the highest-priority enabled pending one (lowest ID
+    // on a tie). It interrupts only above the ceiling: the threshold or the
+    // priority of a handler already running, whichever is higher. A higher
+    // priority source can therefore preempt a running handler once that
+    // handler re-enables MSTATUS.MIE.
+    logic [2:0] bestId, bestPriority, runningPriority, ceiling;
+
+    always_comb begin
+        bestId          = 3'd0;
+        bestPriority    = 3'd0;
+        runningPriority = 3'd0;
+        for (int id = 1; id <= sources; id++) begin
+            if (pending[id] && enable[id] && sourcePriority[id] > bestPriority) begin
+                bestId       = 3'(id);
+                bestPriority = sourcePriority[id];
+            end
+            if (active[id] && sourcePriority[id] > runningPriority) runningPriority = sourcePriority[id];
+        end
+    end
+
+    assign ceiling          = (runningPriority > threshold) ? runningPriority : threshold;
+    assign interruptRequest = (bestId != 3'd0) && (bestPriority > ceiling);
+    assign interruptVector  = mtvec[0] ? ({mtvec[31:2], 2'b00} + {27'b0, bestId, 2'b00}) : {mtvec[31:2], 2'b00};
+
+    // --- 2. CLAIM / COMPLETE ---
+    // Taking the trap claims the best source (pending -> active) in the same
+    // edge, so a vectored handler never races another source for its ID.
+    // Writing the ID to CLAIM completes it and lowers the ceiling again.
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            sourcePrevious <= '0;
+            pending        <= '0;
+            active         <= '0;
+            enable         <= bootSources[sources:0];
+            threshold      <= 3'd0;
+            mtvec          <= 32'h00000010; // Direct mode at the legacy trap vector
+            claimedId      <= 3'd0;
+            for (int id = 1; id <= sources; id++) sourcePriority[id] <= {2'b00, bootSources[id]};
+        end else begin
+            sourcePrevious <= {sourceLevel, 1'b0};
+
+            for (int id = 1; id <= sources; id++) begin
+                if (trapTaken && bestId == 3'(id))
+                    pending[id] <= 1'b0;
+                else if (sourceRise[id] || (registerWriteValid && registerOffset == regPending && registerWriteData[id]))
+                    pending[id] <= 1'b1;
+
+                if (trapTaken && bestId == 3'(id))
+                    active[id] <= 1'b1;
+                else if (registerWriteValid && registerOffset == regClaim && registerWriteData == 32'(id))
+                    active[id] <= 1'b0;
+
+                if (registerWriteValid && registerOffset == regPriority + 8'(4 * id))
+                    sourcePriority[id] <= registerWriteData[2:0];
+            end
+
+            if (trapTaken) claimedId <= bestId;
+
+            if (registerWriteValid) begin
+                case (registerOffset)
+                    regEnable:    enable    <= {registerWriteData[sources:1], 1'b0};
+                    regThreshold: threshold <= registerWriteData[2:0];
+                    regMtvec:     mtvec     <= registerWriteData;
+                    default: ;
+                endcase
+            end
+        end
+    end
+
+    // --- 3. REGISTER READS ---
+    always_comb begin
+        case (registerOffset)
+            regPending:   registerReadData = 32'(pending);
+            regEnable:    registerReadData = 32'(enable);
+            regThreshold: registerReadData = 32'(threshold);
+            regClaim:     registerReadData = 32'(claimedId);
+            regMtvec:     registerReadData = mtvec;
+            regActive:    registerReadData = 32'(active);
+            default: begin
+                registerReadData = 32'b0;
+                for (int id = 1; id <= sources; id++) begin
+                    if (registerOffset == regPriority + 8'(4 * id)) registerReadData = 32'(sourcePriority[id]);
+                end
+            end
+        endcase
+    end
+
+endmodule
@@ -0,0 +1,144 @@
+module rvc_expander (
+    input  logic [31:0] fetchWindow,   // 32 bits starting at the PC (halfword aligned)
+    output logic [31:0] instruction,   // Equivalent 32-bit instruction
+    output logic        isCompressed,  // Low 2 bits != 11: the PC advances by 2
+    output logic        isIllegal      // Reserved or floating-point encoding (expands to 0)
+);
+
+    // RV32C expansion per the RISC-V unprivileged spec, chapter "C" (quadrants
+    // 0-2). Compressed register fields rd'/rs1'/rs2' address x8-x15.
+    // Every expansion is a base RV32I instruction, so RVC firmware relies on
+    // the full base decode: C.SLLI/SRLI/SRAI on the controller's shifts and
+    // C.BNEZ on cpu_core's branch comparator.
+    logic [15:0] c;
+    logic [4:0]  rdFull, rs2Full, lowPrime, highPrime;
+    logic [11:0] immCi, immLw, immLwsp, immSwsp, immAddi4spn, immAddi16sp;
+    logic [20:0] immJump;
+    logic [12:0] immBranch;
+
+    assign c            = fetchWindow[15:0];
+    assign isCompressed = (c[1:0] != 2'b11);
+
+    assign rdFull    = c[11:7];
+    assign rs2Full   = c[6:2];
+    assign lowPrime  = {2'b01, c[4:2]};  // rd' (CIW, CL) or rs2' (CS, CA)
+    assign highPrime = {2'b01, c[9:7]};  // rs1' (CL, CS, CB) or rd'/rs1' (CA, CB ALU ops)
+
+    // Immediates, already scaled and sign/zero-extended to their 32-bit field width
+    assign immCi       = {{7{c[12]}}, c[6:2]};
+    assign immLw       = {5'b0, c[5], c[12:10], c[6], 2'b00};
+    assign immLwsp     = {4'b0, c[3:2], c[12], c[6:4], 2'b00};
+    assign immSwsp     = {4'b0, c[8:7], c[12:9], 2'b00};
+    assign immAddi4spn = {2'b0, c[10:7], c[12:11], c[5], c[6], 2'b00};
+    assign immAddi16sp = {{3{c[12]}}, c[4:3], c[5], c[2], c[6], 4'b0};
+    assign immJump     = {{10{c[12]}}, c[8], c[10:9], c[6], c[7], c[2], c[11], c[5:3], 1'b0};
+    assign immBranch   = {{5{c[12]}}, c[6:5], c[2], c[11:10], c[4:3], 1'b0};
+
+    // --- 1. 32-BIT ENCODERS ---
+    function automatic logic [31:0] encodeI(input logic [11:0] imm, input logic [4:0] rs1, input logic [2:0] funct3,
+                                            input logic [4:0] rd, input logic [6:0] opcode);
+        return {imm, rs1, funct3, rd, opcode};
+    endfunction
+
+    function automatic logic [31:0] encodeS(input logic [11:0] imm, input logic [4:0] rs2, input logic [4:0] rs1,
+                                            input logic [2:0] funct3);
+        return {imm[11:5], rs2, rs1, funct3, imm[4:0], 7'b0100011};
+    endfunction
+
+    function automatic logic [31:0] encodeR(input logic [6:0] funct7, input logic [4:0] rs2, input logic [4:0] rs1,
+                                            input logic [2:0] funct3, input logic [4:0] rd);
+        return {funct7, rs2, rs1, funct3, rd, 7'b0110011};
+    endfunction
+
+    function automatic logic [31:0] encodeB(input logic [12:0] imm, input logic [4:0] rs1, input logic [2:0] funct3);
+        return {imm[12], imm[10:5], 5'd0, rs1, funct3, imm[4:1], imm[11], 7'b1100011};
+    endfunction
+
+    function automatic logic [31:0] encodeJ(input logic [20:0] imm, input logic [4:0] rd);
+        return {imm[20], imm[10:1], imm[11], imm[19:12], rd, 7'b1101111};
+    endfunction
+
+    // --- 2. EXPANSION ---
+    always_comb begin
+        instruction = fetchWindow;
+        isIllegal   = 1'b0;
+
+        if (isCompressed) begin
+            instruction = 32'b0;
+            case ({c[1:0], c[15:13]})
+                // Quadrant 0
+                5'b00_000: begin // C.ADDI4SPN -> addi rd', x2, nzuimm
+                    instruction = encodeI(immAddi4spn, 5'd2, 3'b000, lowPrime, 7'b0010011);
+                    isIllegal   = (immAddi4spn == 12'b0);
+                end
+                5'b00_010: instruction = encodeI(immLw, highPrime, 3'b010, lowPrime, 7'b0000011); // C.LW
+                5'b00_110: instruction = encodeS(immLw, lowPrime, highPrime, 3'b010);             // C.SW
+
+                // Quadrant 1
+                5'b01_000: instruction = encodeI(immCi, rdFull, 3'b000, rdFull, 7'b0010011);     // C.ADDI / C.NOP
+                5'b01_001: instruction = encodeJ(immJump, 5'd1);                                 // C.JAL
+                5'b01_010: instruction = encodeI(immCi, 5'd0, 3'b000, rdFull, 7'b0010011);       // C.LI
+                5'b01_011: begin
+                    if (rdFull == 5'd2)                                                          // C.ADDI16SP
+                        instruction = encodeI(immAddi16sp, 5'd2, 3'b000, 5'd2, 7'b0010011);
+                    else                                                                         // C.LUI
+                        instruction = {{15{c[12]}}, c[6:2], rdFull, 7'b0110111};
+                    isIllegal = ({c[12], c[6:2]} == 6'b0);
+                end
+                5'b01_100: begin
+                    case (c[11:10])
+                        2'b00: instruction = encodeI({7'b0000000, c[6:2]}, highPrime, 3'b101, highPrime, 7'b0010011); // C.SRLI
+                        2'b01: instruction = encodeI({7'b0100000, c[6:2]}, highPrime, 3'b101, highPrime, 7'b0010011); // C.SRAI
+                        2'b10: instruction = encodeI(immCi, highPrime, 3'b111, highPrime, 7'b0010011);                // C.ANDI
+                        2'b11: begin
+                            case (c[6:5])
+                                2'b00: instruction = encodeR(7'b0100000, lowPrime, highPrime, 3'b000, highPrime); // C.SUB
+                                2'b01: instruction = encodeR(7'b0000000, lowPrime, highPrime, 3'b100, highPrime); // C.XOR
+                                2'b10: instruction = encodeR(7'b0000000, lowPrime, highPrime, 3'b110, highPrime); // C.OR
+                                2'b11: instruction = encodeR(7'b0000000, lowPrime, highPrime, 3'b111, highPrime); // C.AND
+                            endcase
+                            isIllegal = c[12]; // RV64 SUBW/ADDW
+                        end
+                    endcase
+                    if (c[11:10] != 2'b10 && c[11:10] != 2'b11) isIllegal = c[12]; // shamt[5] must be 0 on RV32
+                end
+                5'b01_101: instruction = encodeJ(immJump, 5'd0);                                 // C.J
+                5'b01_110: instruction = encodeB(immBranch, highPrime, 3'b000);                  // C.BEQZ
+                5'b01_111: instruction = encodeB(immBranch, highPrime, 3'b001);                  // C.BNEZ
+
+                // Quadrant 2
+                5'b10_000: begin // C.SLLI
+                    instruction = encodeI({7'b0000000, c[6:2]}, rdFull, 3'b001, rdFull, 7'b0010011);
+                    isIllegal   = c[12];
+                end
+                5'b10_010: begin // C.LWSP
+                    instruction = encodeI(immLwsp, 5'd2, 3'b010, rdFull, 7'b0000011);
+                    isIllegal   = (rdFull == 5'd0);
+                end
+                5'b10_100: begin
+                    if (!c[12]) begin
+                        if (rs2Full == 5'd0) begin                                               // C.JR
+                            instruction = encodeI(12'b0, rdFull, 3'b000, 5'd0, 7'b1100111);
+                            isIllegal   = (rdFull == 5'd0);
+                        end else                                                                 // C.MV
+                            instruction = encodeR(7'b0000000, rs2Full, 5'd0, 3'b000, rdFull);
+                    end else begin
+                        if (rdFull == 5'd0 && rs2Full == 5'd0)                                   // C.EBREAK
+                            instruction = 32'h00100073;
+                        else if (rs2Full == 5'd0)                                                // C.JALR
+                            instruction = encodeI(12'b0, rdFull, 3'b000, 5'd1, 7'b1100111);
+                        else                                                                     // C.ADD
+                            instruction = encodeR(7'b0000000, rs2Full, rdFull, 3'b000, rdFull);
+                    end
+                end
+                5'b10_110: instruction = encodeS(immSwsp, rs2Full, 5'd2, 3'b010);                // C.SWSP
+
+                // Reserved, and the F/D load/store forms (no FPU)
+                default:   isIllegal = 1'b1;
+            endcase
+
+            if (isIllegal) instruction = 32'b0;
+        end
+    end
+
+endmodule
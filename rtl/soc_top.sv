@@ -1,4 +1,24 @@
-module soc_top (
+module soc_top #(
+    // Instruction source: 0 = 4KB combinational ROM, 1 = I-cache in front of XIP flash
+    parameter ICACHE_ENABLE = 0,
+    parameter ICACHE_WAYS   = 2,   // 1: direct-mapped, 2: two-way LRU
+    parameter ICACHE_SETS   = 16,
+    parameter FLASH_LATENCY = 8,   // Flash cycles to first word
+    // Memory read timing: 0 = combinational ROM/RAM reads, 1 = registered (block RAM) reads
+    parameter MEMORY_SYNC_READ = 0,
+    // Harts sharing ROM image, RAM and MMIO; harts beyond 0 need ICACHE_ENABLE=0, MEMORY_SYNC_READ=0
+    parameter HARTS = 1,
+    // Custom-instruction accelerator per hart: 0 = none (custom ops write 0), 1 = accel_crc32
+    parameter ACCEL_ENABLE       = 1,
+    parameter CRC_BITS_PER_CYCLE = 8,   // 32: single-cycle crc32.w, 8: four-cycle crc32.w
+    // Timing and sizing knobs (see sweep.sh); run.sh passes overrides on to the harness
+    parameter CLOCK_DIVIDER_BITS  = 3,      // CPU clock = system clock / 2^N (3: 12.5 MHz from 100 MHz)
+    parameter TIMER_LIMIT         = 10000,  // Timer counts 0..TIMER_LIMIT: one tick per TIMER_LIMIT + 1 CPU cycles
+    parameter TIMER_HIGH_CYCLES   = 2000,   // Cycles per period the timer level is high (the IRQ takes the rising edge only)
+    parameter UART_CLOCKS_PER_BIT = 108,    // UART reset divisor (115200 baud at 12.5 MHz)
+    parameter ROM_WORDS           = 1024,   // Instruction ROM depth (power of two, >= the firmware image)
+    parameter RAM_WORDS           = 1024    // Data RAM depth (power of two, >= link.ld's RAM)
+) (
     input  logic       clock,          
     input  logic       resetActiveLow, 
     output logic [7:0] debugLeds,      
@@ -7,101 +27,190 @@ module soc_top (
 
     // --- 1. CLOCK & SYSTEM TIMING ---
     logic       cpuClock;
-    logic [2:0] clockDivider;
-    logic [31:0] timerCount;
-    logic        timerInterrupt /* verilator public_flat */;
+    logic [CLOCK_DIVIDER_BITS-1:0] clockDivider;
+    logic        timerInterrupt; // Hart 0's timer
+    logic [HARTS-1:0] hartTimerInterrupt;
 
-    assign cpuClock = clockDivider[2]; 
+    assign cpuClock = clockDivider[CLOCK_DIVIDER_BITS-1];
     always_ff @(posedge clock) clockDivider <= clockDivider + 1;
 
-    localparam TIMER_LIMIT = 10000; 
-    always_ff @(posedge cpuClock or negedge resetActiveLow) begin
-        if (!resetActiveLow) begin
-            timerCount     <= 0;
-            timerInterrupt <= 0;
-        end else begin
-            if (timerCount >= TIMER_LIMIT) timerCount <= 0;
-            else                           timerCount <= timerCount + 1;
-            timerInterrupt <= (timerCount < 2000); 
+    // One timer per hart, phase-staggered so the harts are not preempted together
+    genvar hart;
+    generate
+        for (hart = 0; hart < HARTS; hart++) begin : gen_timer
+            logic [31:0] timerCount;
+            logic        timerLevel;
+            always_ff @(posedge cpuClock or negedge resetActiveLow) begin
+                if (!resetActiveLow) begin
+                    timerCount <= hart * (TIMER_LIMIT / HARTS);
+                    timerLevel <= 0;
+                end else begin
+                    if (timerCount >= TIMER_LIMIT) timerCount <= 0;
+                    else                           timerCount <= timerCount + 1;
+                    timerLevel <= (timerCount < TIMER_HIGH_CYCLES);
+                end
+            end
+            assign hartTimerInterrupt[hart] = timerLevel;
         end
+    endgenerate
+    assign timerInterrupt = hartTimerInterrupt[0];
+
+    // Free-running cycle counter (host region 0x40000108/0x4000010C)
+    logic [63:0] cycleCounter;
+    always_ff @(posedge cpuClock or negedge resetActiveLow) begin
+        if (!resetActiveLow) cycleCounter <= 64'b0;
+        else                 cycleCounter <= cycleCounter + 1;
     end
 
-    // --- 2. INSTRUCTION FETCH & PC LOGIC ---
-    logic [31:0] programCounter /* verilator public_flat */; 
-    logic [31:0] nextProgramCounter, instruction, immediateValue, mepcValue;
-    logic        isTrap, isReturn, isBranch, zeroFlag;
-
-    assign nextProgramCounter = 
-        (isTrap || timerInterrupt)      ? 32'h00000010 :
-        isReturn                        ? mepcValue    :
-        (isBranch && (instruction[6:0] == 7'b1100111)) ? aluResult :
-        (isBranch && (zeroFlag || (instruction[6:0] == 7'b1101111))) ? (programCounter + immediateValue) :
-                                          (programCounter + 4);
-
-    pc_reg u_pc (
-        .clock(cpuClock), .resetActiveLow(resetActiveLow), .enable(1'b1), 
-        .nextProgramCounter(nextProgramCounter), .programCounter(programCounter)
-    );
+    // --- 2. HARTS ---
+    // cpu_core holds the datapath, control, MEPC and the hart-local CSR
+    // window; each hart has its own accelerator on the custom-0/1 port.
+    // Hart 0's fetch and status signals are aliased here for the fetch
+    // path and the simulation monitor; other harts run from private copies
+    // of the ROM image.
+    localparam ID_BITS = (HARTS > 1) ? $clog2(HARTS) : 1;
 
-    // --- 3. CORE DATAPATH & CONTROL ---
-    logic [31:0] readData1, readData2, aluResult, busReadData, alignedReadData;
-    logic [2:0]  aluControl;
-    logic        registerWriteEnable, memoryWriteEnable, aluInputSource, resultSource, csrWriteEnable;
-
-    controller u_ctrl (
-        .opcode(instruction[6:0]), .funct3(instruction[14:12]), .funct7(instruction[31:25]),
-        .timerInterrupt(timerInterrupt), .registerWriteEnable(registerWriteEnable), 
-        .aluInputSource(aluInputSource), .memoryWriteEnable(memoryWriteEnable), 
-        .resultSource(resultSource), .isBranch(isBranch), .aluControlSignal(aluControl), 
-        .csrWriteEnable(csrWriteEnable), .isTrap(isTrap), .isReturn(isReturn)
-    );
+    logic [31:0] programCounter;
+    logic [31:0] instruction;    // Hart 0, after RVC expansion
+    logic [31:0] fetchWindow;
+    logic        coreStall;
+    logic        fetchReady;
+    logic [31:0] romFetchAddress;
 
-    always_comb begin
-        alignedReadData = busReadData; 
-        if (instruction[6:0] == 7'b0000011 && instruction[14:12] == 3'b100) begin
-            case (aluResult[1:0])
-                2'b00: alignedReadData = {24'b0, busReadData[7:0]};   
-                2'b01: alignedReadData = {24'b0, busReadData[15:8]};  
-                2'b10: alignedReadData = {24'b0, busReadData[23:16]}; 
-                2'b11: alignedReadData = {24'b0, busReadData[31:24]}; 
-            endcase
+    logic [31:0]      hartPc          [0:HARTS-1];
+    logic [31:0]      hartFetchAddress[0:HARTS-1];
+    logic [31:0]      hartFetchWindow [0:HARTS-1];
+    logic [31:0]      hartInstruction [0:HARTS-1];
+    logic [31:0]      hartAddress     [0:HARTS-1];
+    logic [31:0]      hartWriteData   [0:HARTS-1];
+    logic [3:0]       hartStrobe      [0:HARTS-1];
+    logic [HARTS-1:0] hartFetchReady, hartStall, hartRequest, hartGrant, hartReadValid, hartWriteValid;
+    logic [HARTS-1:0] hartLoadReserve, hartStoreConditional, hartTrap, hartSoftwareInterrupt;
+    logic [HARTS-1:0] hartInterruptRequest, hartAccelValid, hartAccelCustom1, hartAccelReady;
+    logic [2:0]       hartAccelFunct3 [0:HARTS-1];
+    logic [6:0]       hartAccelFunct7 [0:HARTS-1];
+    logic [31:0]      hartAccelOperandA [0:HARTS-1];
+    logic [31:0]      hartAccelOperandB [0:HARTS-1];
+    logic [31:0]      hartAccelResult [0:HARTS-1];
+    logic [31:0]      hartInterruptVector [0:HARTS-1];
+    logic [HARTS-1:0] hartRetireValid, hartRetireRegisterWrite;
+    logic [31:0]      hartRetireRegisterData [0:HARTS-1];
+    logic [ID_BITS-1:0] grantedHart;
+    logic [31:0] busReadData;
+    logic        storeConditionalSuccess;
+
+    generate
+        for (hart = 0; hart < HARTS; hart++) begin : gen_hart
+            cpu_core #(.HART_ID(hart), .MEMORY_SYNC_READ(MEMORY_SYNC_READ)) u_core (
+                .clock(cpuClock), .resetActiveLow(resetActiveLow),
+                .interruptRequest(hartInterruptRequest[hart]), .interruptVector(hartInterruptVector[hart]),
+                .programCounter(hartPc[hart]), .fetchAddress(hartFetchAddress[hart]),
+                .fetchWindow(hartFetchWindow[hart]), .instruction(hartInstruction[hart]), .fetchReady(hartFetchReady[hart]), .coreStall(hartStall[hart]),
+                .dataRequest(hartRequest[hart]), .dataGrant(hartGrant[hart]), .dataAddress(hartAddress[hart]),
+                .dataReadValid(hartReadValid[hart]), .dataWriteValid(hartWriteValid[hart]),
+                .dataWriteData(hartWriteData[hart]), .dataStrobe(hartStrobe[hart]), .dataReadData(busReadData),
+                .loadReserve(hartLoadReserve[hart]), .storeConditional(hartStoreConditional[hart]),
+                .storeConditionalSuccess(storeConditionalSuccess), .trapTaken(hartTrap[hart]), .mepcValue(),
+                .accelValid(hartAccelValid[hart]), .accelCustom1(hartAccelCustom1[hart]),
+                .accelFunct3(hartAccelFunct3[hart]), .accelFunct7(hartAccelFunct7[hart]),
+                .accelOperandA(hartAccelOperandA[hart]), .accelOperandB(hartAccelOperandB[hart]),
+                .accelResult(hartAccelResult[hart]), .accelReady(hartAccelReady[hart]),
+                .retireValid(hartRetireValid[hart]), .retireRegisterWrite(hartRetireRegisterWrite[hart]),
+                .retireRegisterData(hartRetireRegisterData[hart])
+            );
+
+            if (ACCEL_ENABLE) begin : gen_accel
+                accel_crc32 #(.bitsPerCycle(CRC_BITS_PER_CYCLE)) u_accel (
+                    .clock(cpuClock), .resetActiveLow(resetActiveLow),
+                    .accelValid(hartAccelValid[hart]), .accelCustom1(hartAccelCustom1[hart]),
+                    .accelFunct3(hartAccelFunct3[hart]), .accelFunct7(hartAccelFunct7[hart]),
+                    .accelOperandA(hartAccelOperandA[hart]), .accelOperandB(hartAccelOperandB[hart]),
+                    .accelResult(hartAccelResult[hart]), .accelReady(hartAccelReady[hart])
+                );
+            end else begin : gen_no_accel
+                assign hartAccelResult[hart] = 32'b0;
+                assign hartAccelReady[hart]  = 1'b1;
+            end
+
+            if (hart == 0) begin : gen_boot_hart
+                assign hartFetchWindow[hart] = fetchWindow;
+                assign hartFetchReady[hart]  = fetchReady;
+            end else begin : gen_secondary_hart
+                inst_mem #(.romWords(ROM_WORDS)) u_rom_copy (
+                    .clock(cpuClock), .romAxiReadAddress(hartFetchAddress[hart]), .romAxiReadData(hartFetchWindow[hart]),
+                    .busReadAddress(32'b0), .busReadData()
+                );
+                assign hartFetchReady[hart] = 1'b1;
+            end
         end
-    end
 
-    regfile u_rf (
-        .clock(cpuClock), .registerWriteEnable(registerWriteEnable),
-        .readAddress0(instruction[19:15]), .readAddress1(instruction[24:20]), 
-        .writeAddress(instruction[11:7]), 
-        .writeData(resultSource ? alignedReadData : ((instruction[6:0] == 7'b1101111 || instruction[6:0] == 7'b1100111) ? (programCounter + 4) : aluResult)), 
-        .readData0(readData1), .readData1(readData2) 
-    );
+        if (HARTS > 1 && (ICACHE_ENABLE || MEMORY_SYNC_READ)) begin : gen_harts_unsupported
+            $error("soc_top: HARTS > 1 requires ICACHE_ENABLE=0 and MEMORY_SYNC_READ=0");
+        end
+    endgenerate
+
+    assign programCounter  = hartPc[0];
+    assign instruction     = hartInstruction[0];
+    assign romFetchAddress = hartFetchAddress[0];
+    assign coreStall       = hartStall[0];
 
-    alu u_alu (
-        .inputA((instruction[6:0] == 7'b0110111) ? 32'b0 : readData1), 
-        .inputB(aluInputSource ? immediateValue : readData2),
-        .aluControl(aluControl), .aluResult(aluResult), .zero(zeroFlag)
+    // Round-robin arbitration for the CPU master port; the loser stalls a cycle
+    hart_arbiter #(.HARTS(HARTS)) u_arbiter (
+        .clock(cpuClock), .resetActiveLow(resetActiveLow),
+        .request(hartRequest), .grant(hartGrant), .grantedHart(grantedHart)
     );
 
-    // --- 4. BUS, MEMORY & PERIPHERALS ---
-    logic [31:0] ioWriteAddress /* verilator public_flat */;
-    logic [31:0] ioWriteData    /* verilator public_flat */;
-    logic        ioWriteValid   /* verilator public_flat */;
+    logic [31:0] cpuAddress, cpuWriteData;
+    logic [3:0]  cpuStrobe;
+    logic        cpuReadValid, cpuWriteValid, cpuLoadReserve, cpuStoreConditional;
+    always_comb begin
+        cpuAddress = 32'b0; cpuWriteData = 32'b0; cpuStrobe = 4'b0; cpuReadValid = 1'b0; cpuWriteValid = 1'b0;
+        cpuLoadReserve = 1'b0; cpuStoreConditional = 1'b0;
+        for (int index = 0; index < HARTS; index++) begin
+            if (hartGrant[index]) begin
+                cpuAddress          = hartAddress[index];
+                cpuWriteData        = hartWriteData[index];
+                cpuStrobe           = hartStrobe[index];
+                cpuReadValid        = hartReadValid[index];
+                cpuWriteValid       = hartWriteValid[index];
+                cpuLoadReserve      = hartLoadReserve[index];
+                cpuStoreConditional = hartStoreConditional[index];
+            end
+        end
+    end
+
+    // --- 3. BUS, MEMORY & PERIPHERALS ---
+    logic [31:0] ioWriteAddress, ioWriteData;
+    logic        ioWriteValid;
     logic [31:0] ramWriteAddress, ramReadAddress, ramWriteData, romBusAddress, romBusData, ioReadAddress;
     logic [31:0] ramReadData; 
-    logic        ramWriteValid, uartIsBusy;
+    logic [3:0]  ramWriteStrobe;
+    logic        ramWriteValid, uartIsBusy, uartIsFull;
+    logic [15:0] uartDivisor;
+    logic [31:0] busPerfValue, irqReadData;
+
+    // Software interrupts (MMIO 0x40000018): writing a hart mask pulses an IPI to each hart set
+    always_comb begin
+        for (int index = 0; index < HARTS; index++) begin
+            hartSoftwareInterrupt[index] = ioWriteValid && (ioWriteAddress == 32'h40000018) && ioWriteData[index];
+        end
+    end
 
-    bus_interconnect u_bus (
+    bus_interconnect #(.HARTS(HARTS)) u_bus (
         .clock(cpuClock), .resetActiveLow(resetActiveLow),
         
         // CPU Master Interface
-        .cpuAxiWriteAddress(aluResult), .cpuAxiWriteValid(memoryWriteEnable), .cpuAxiWriteReady(), // FIXED HERE
-        .cpuAxiWriteData(readData2), .cpuAxiWriteValidData(1'b1), .cpuAxiWriteReadyData(),
-        .cpuAxiReadAddress(aluResult), .cpuAxiReadValid(resultSource), .cpuAxiReadReady(),
+        .cpuAxiWriteAddress(cpuAddress), .cpuAxiWriteValid(cpuWriteValid), .cpuAxiWriteReady(), // FIXED HERE
+        .cpuAxiWriteData(cpuWriteData), .cpuAxiWriteValidData(1'b1), .cpuAxiWriteReadyData(),
+        .cpuAxiWriteStrobe(cpuStrobe),
+        .cpuAxiReadAddress(cpuAddress), .cpuAxiReadValid(cpuReadValid), .cpuAxiReadReady(),
+        .cpuAxiReadStrobe(cpuStrobe),
         .cpuAxiReadData(busReadData), .cpuAxiReadValidData(), .cpuAxiReadReadyData(1'b1),
 
         // DMA Master Interface (Unused)
         .dmaAxiWriteAddress(32'b0), .dmaAxiWriteValid(1'b0), .dmaAxiWriteReady(),
         .dmaAxiWriteData(32'b0), .dmaAxiWriteValidData(1'b0), .dmaAxiWriteReadyData(),
+        .dmaAxiWriteStrobe(4'b1111),
         .dmaAxiReadAddress(32'b0), .dmaAxiReadValid(1'b0), .dmaAxiReadReady(),
         .dmaAxiReadData(), .dmaAxiReadValidData(), .dmaAxiReadReadyData(1'b1),
 
@@ -112,6 +221,7 @@ module soc_top (
         // RAM Slave Interface
         .ramAxiWriteAddress(ramWriteAddress), .ramAxiWriteValid(ramWriteValid), .ramAxiWriteReady(1'b1),
         .ramAxiWriteData(ramWriteData), .ramAxiWriteValidData(), .ramAxiWriteReadyData(1'b1),
+        .ramAxiWriteStrobe(ramWriteStrobe),
         .ramAxiReadAddress(ramReadAddress), .ramAxiReadValid(), .ramAxiReadReady(1'b1),
         .ramAxiReadData(ramReadData), .ramAxiReadValidData(1'b1), .ramAxiReadReadyData(),
 
@@ -119,32 +229,153 @@ module soc_top (
         .ioAxiWriteAddress(ioWriteAddress), .ioAxiWriteValid(ioWriteValid), .ioAxiWriteReady(1'b1),
         .ioAxiWriteData(ioWriteData), .ioAxiWriteValidData(), .ioAxiWriteReadyData(1'b1),
         .ioAxiReadAddress(ioReadAddress), .ioAxiReadValid(), .ioAxiReadReady(1'b1),
-        .ioAxiReadData((ioReadAddress == 32'h40000004) ? {31'b0, uartIsBusy} : 
-                       (ioReadAddress == 32'h40000010) ? mepcValue : 32'b0),
-        .ioAxiReadValidData(1'b1), .ioAxiReadReadyData()
-    );
+        .ioAxiReadData((ioReadAddress == 32'h40000004) ? {30'b0, uartIsBusy, uartIsFull} : 
+                       (ioReadAddress == 32'h40000008) ? {16'b0, uartDivisor} :
+                       (ioReadAddress == 32'h4000001C) ? 32'(HARTS) :
+                       (ioReadAddress == 32'h40000108) ? cycleCounter[31:0] :
+                       (ioReadAddress == 32'h4000010C) ? cycleCounter[63:32] :
+                       (ioReadAddress[31:6] == 26'h1000008) ? busPerfValue :
+                       (ioReadAddress == 32'h40000300) ? icacheHits   :
+                       (ioReadAddress == 32'h40000304) ? icacheMisses :
+                       (ioReadAddress == 32'h40000308) ? icacheStalls :
+                       (ioReadAddress[31:8] == 24'h400004) ? irqReadData : 32'b0),
+        .ioAxiReadValidData(1'b1), .ioAxiReadReadyData(),
 
-    csr_unit u_csr (
-        .clock(cpuClock), .resetActiveLow(resetActiveLow),
-        .csrWriteEnable(csrWriteEnable), .pcFromCore(programCounter), 
-        .busWriteEnable((ioWriteValid && (ioWriteAddress == 32'h40000010)) || timerInterrupt), 
-        .busWriteData(timerInterrupt ? programCounter : ioWriteData), 
-        .mepcValue(mepcValue)
+        // LR/SC reservation: a trap entry invalidates the trapping hart's reservation
+        .cpuMasterId(grantedHart), .cpuLoadReserve(cpuLoadReserve), .cpuStoreConditional(cpuStoreConditional),
+        .reservationClear(hartTrap), .storeConditionalSuccess(storeConditionalSuccess),
+
+        // Performance Counters (MMIO 0x40000200: read counter N at +4*N, write clears)
+        .cpuArbitrationLoss(|(hartRequest & ~hartGrant)),
+        .perfCounterClear(ioWriteValid && (ioWriteAddress == 32'h40000200)),
+        .perfCounterSelect(ioReadAddress[5:2]), .perfCounterValue(busPerfValue)
     );
 
-    uart_tx #(.clocksPerBit(108)) u_uart (
+    // Baud divisor resets to UART_CLOCKS_PER_BIT; firmware may reprogram it at 0x40000008
+    uart_tx #(.clocksPerBit(UART_CLOCKS_PER_BIT)) u_uart (
         .systemClock(cpuClock), 
         .transmitDataValid(ioWriteValid && (ioWriteAddress == 32'h40000000)), 
         .transmitByte(ioWriteData[7:0]), 
+        .divisorWriteValid(ioWriteValid && (ioWriteAddress == 32'h40000008)),
+        .divisorWriteData(ioWriteData[15:0]),
+        .divisorValue(uartDivisor),
         .serialDataOutput(uartTransmit), 
         .isTransmitActive(uartIsBusy), 
+        .isTransmitBufferFull(uartIsFull),
         .isTransmitDone()
     );
 
-    inst_mem u_rom (.romAxiReadAddress(programCounter), .romAxiReadData(instruction), .busReadAddress(romBusAddress), .busReadData(romBusData));
-    data_mem u_ram (.clock(cpuClock), .ramAxiWriteAddress(ramWriteAddress), .ramAxiWriteData(ramWriteData), .ramAxiWriteValid(ramWriteValid), .ramAxiReadAddress(ramReadAddress), .ramAxiReadData(ramReadData));
-    imm_gen  u_imm_gen (.instruction(instruction), .immediateValue(immediateValue));
+    // --- 4. INTERRUPT CONTROLLERS ---
+    // One per hart, in the hart-local window 0x40000400-0x4000043F: each hart
+    // programs and claims only its own controller, and reads are returned for
+    // the hart that owns the bus. Source IDs (bit N of PENDING/ENABLE):
+    //   1 timer, 2 UART TX holding register free, 3 DMA done, 4 software (IPI)
+    // Out of reset the timer and software sources are enabled at priority 1.
+    localparam IRQ_SOURCES = 4;
+    logic [31:0] hartIrqReadData [0:HARTS-1];
+
+    generate
+        for (hart = 0; hart < HARTS; hart++) begin : gen_irq
+            irq_controller #(.sources(IRQ_SOURCES), .bootSources(8'b0001_0010)) u_irq (
+                .clock(cpuClock), .resetActiveLow(resetActiveLow),
+                // No DMA master is instantiated yet, so DMA done is tied low
+                .sourceLevel({hartSoftwareInterrupt[hart], 1'b0, !uartIsFull, hartTimerInterrupt[hart]}),
+                .registerOffset(hartAddress[hart][7:0]),
+                .registerWriteValid(hartWriteValid[hart] && (hartAddress[hart][31:8] == 24'h400004)),
+                .registerWriteData(hartWriteData[hart]),
+                .registerReadData(hartIrqReadData[hart]),
+                .interruptRequest(hartInterruptRequest[hart]), .interruptVector(hartInterruptVector[hart]),
+                .trapTaken(hartTrap[hart])
+            );
+        end
+    endgenerate
+
+    assign irqReadData = hartIrqReadData[grantedHart];
+
+    // --- 5. INSTRUCTION SOURCE ---
+    // u_rom is always present: it is the default fetch path and the image the
+    // testbench backdoor reads. With ICACHE_ENABLE, fetch and ROM-constant
+    // reads come from the flash model instead (same image, larger window).
+    logic [31:0] romInstruction, romPortData, cacheInstruction, flashPortData;
+    logic [31:0] icacheHits   /* verilator public_flat */;
+    logic [31:0] icacheMisses /* verilator public_flat */;
+    logic [31:0] icacheStalls /* verilator public_flat */;
+
+    // A registered ROM is addressed by the core with the PC being loaded this edge
+    inst_mem #(.syncRead(MEMORY_SYNC_READ), .romWords(ROM_WORDS)) u_rom (.clock(cpuClock), .romAxiReadAddress(romFetchAddress), .romAxiReadData(romInstruction), .busReadAddress(romBusAddress), .busReadData(romPortData));
+
+    generate
+        if (ICACHE_ENABLE) begin : gen_icache
+            logic                lineRequestValid, lineRequestReady, lineResponseValid;
+            logic [31:0]         lineRequestAddress;
+            logic [4*32-1:0]     lineResponseData;
+
+            icache #(.ways(ICACHE_WAYS), .sets(ICACHE_SETS), .lineWords(4)) u_icache (
+                .clock(cpuClock), .resetActiveLow(resetActiveLow),
+                .fetchAddress(programCounter), .fetchEnable(!coreStall),
+                .fetchData(cacheInstruction), .fetchReady(fetchReady),
+                .lineRequestValid(lineRequestValid), .lineRequestAddress(lineRequestAddress),
+                .lineRequestReady(lineRequestReady), .lineResponseValid(lineResponseValid),
+                .lineResponseData(lineResponseData),
+                .hitCount(icacheHits), .missCount(icacheMisses), .stallCycles(icacheStalls)
+            );
+
+            flash_model #(.lineWords(4), .firstWordLatency(FLASH_LATENCY)) u_flash (
+                .clock(cpuClock), .resetActiveLow(resetActiveLow),
+                .lineRequestValid(lineRequestValid), .lineRequestAddress(lineRequestAddress),
+                .lineRequestReady(lineRequestReady), .lineResponseValid(lineResponseValid),
+                .lineResponseData(lineResponseData),
+                .busReadAddress(romBusAddress), .busReadData(flashPortData)
+            );
+        end else begin : gen_rom
+            assign fetchReady       = 1'b1;
+            assign cacheInstruction = 32'b0;
+            assign flashPortData    = 32'b0;
+            assign icacheHits       = 32'b0;
+            assign icacheMisses     = 32'b0;
+            assign icacheStalls     = 32'b0;
+        end
+    endgenerate
+
+    // The cache returns whole words: a compressed instruction in the upper
+    // half is shifted down, but a 32-bit one straddling two words is not
+    // supported, so RVC firmware should use the ROM fetch path.
+    assign fetchWindow = !ICACHE_ENABLE         ? romInstruction :
+                         programCounter[1]      ? {16'b0, cacheInstruction[31:16]} : cacheInstruction;
+    assign romBusData  = ICACHE_ENABLE ? flashPortData    : romPortData;
+
+    data_mem #(.syncRead(MEMORY_SYNC_READ), .ramWords(RAM_WORDS)) u_ram (.clock(cpuClock), .ramAxiWriteAddress(ramWriteAddress), .ramAxiWriteData(ramWriteData), .ramAxiWriteStrobe(ramWriteStrobe), .ramAxiWriteValid(ramWriteValid), .ramAxiReadAddress(ramReadAddress), .ramAxiReadData(ramReadData));
 
     assign debugLeds = programCounter[9:2];
 
+    // --- 6. SIMULATION MONITOR (DPI-C) ---
+    // Hart 0's commits, every CPU bus write, trap entries and timer events
+    // are pushed to the harness (sim/soc_monitor.h) as they happen, sampled
+    // at the committing edge. Nothing here is public, so Verilator is free
+    // to optimise the datapath; only the memory arrays (backdoor), the bus
+    // counters and the cache counters keep public_flat for on-demand reads.
+`ifdef VERILATOR
+    import "DPI-C" function void monitor_retire(
+        input int pc, input int instruction,
+        input bit registerWrite, input int registerData,
+        input bit busRead, input bit busWrite, input int busAddress, input int busData);
+    import "DPI-C" function void monitor_write(input int address, input int data);
+    import "DPI-C" function void monitor_trap(input int pc, input int vector);
+    import "DPI-C" function void monitor_timer(input int pc);
+
+    logic monitorTimerLevel;
+    always_ff @(posedge cpuClock) begin
+        monitorTimerLevel <= timerInterrupt;
+        if (resetActiveLow) begin
+            if (hartRetireValid[0])
+                monitor_retire(hartPc[0], hartInstruction[0],
+                               hartRetireRegisterWrite[0], hartRetireRegisterData[0],
+                               hartReadValid[0], hartWriteValid[0], hartAddress[0], hartWriteData[0]);
+            if (hartTrap[0])                          monitor_trap(hartPc[0], hartInterruptVector[0]);
+            if (cpuWriteValid)                        monitor_write(cpuAddress, cpuWriteData);
+            if (timerInterrupt && !monitorTimerLevel) monitor_timer(hartPc[0]);
+        end
+    end
+`endif
+
 endmodule
\ No newline at end of file
@@ -2,7 +2,11 @@ module uart_tx #(parameter clocksPerBit = 108) (
     input        systemClock,
     input        transmitDataValid,
     input  [7:0] transmitByte,
+    input        divisorWriteValid,  // Runtime baud update (applied at next frame)
+    input [15:0] divisorWriteData,   // New clocks-per-bit value (0 is ignored)
+    output [15:0] divisorValue,      // Currently programmed clocks-per-bit
     output       isTransmitActive,
+    output       isTransmitBufferFull, // High when the holding register is occupied
     output reg   serialDataOutput,
     output       isTransmitDone
 );
@@ -22,7 +26,32 @@ module uart_tx #(parameter clocksPerBit = 108) (
     reg        transmitDoneFlag   = 0;
     reg        transmitActiveFlag = 0;
 
+    // Baud divisor: 'programmedDivisor' is software-visible, 'frameDivisor'
+    // is latched at the start of every frame so a write never corrupts a
+    // character that is already on the wire.
+    reg [15:0] programmedDivisor  = clocksPerBit;
+    reg [15:0] frameDivisor       = clocksPerBit;
+
+    // Single-entry holding register: lets software queue the next byte while
+    // the current one is shifting out, so frames go back-to-back with no gap.
+    reg [7:0]  pendingByte        = 0;
+    reg        pendingValid       = 0;
+
+    wire       nextByteReady = pendingValid || transmitDataValid;
+    wire [7:0] nextByte      = pendingValid ? pendingByte : transmitByte;
+
+    always @(posedge systemClock) begin
+        if (divisorWriteValid && divisorWriteData != 16'd0)
+            programmedDivisor <= divisorWriteData;
+    end
+
     always @(posedge systemClock) begin
+        // Accept a new byte into the holding register while busy
+        if (mainStateMachine != stateIdle && transmitDataValid && !pendingValid) begin
+            pendingByte  <= transmitByte;
+            pendingValid <= 1'b1;
+        end
+
         case (mainStateMachine)
             
             // Wait for transmit pulse; reset counters
@@ -33,17 +62,24 @@ module uart_tx #(parameter clocksPerBit = 108) (
                 clockCycleCounter  <= 0;
                 bitIndexCounter    <= 0;
 
-                if (transmitDataValid == 1'b1) begin
+                if (nextByteReady == 1'b1) begin
                     transmitActiveFlag <= 1'b1;
-                    transmitDataBuffer <= transmitByte;
+                    transmitDataBuffer <= nextByte;
+                    frameDivisor       <= programmedDivisor;
                     mainStateMachine   <= stateTransmitStart;
+                    if (pendingValid) begin
+                        // Holding register drained; refill it if a byte arrives now
+                        pendingByte  <= transmitByte;
+                        pendingValid <= transmitDataValid;
+                    end
                 end
             end
 
             // Drive line LOW for 1 bit period (Start Bit)
             stateTransmitStart: begin
                 serialDataOutput <= 1'b0;
-                if (clockCycleCounter < clocksPerBit - 1) begin
+                transmitDoneFlag <= 1'b0;
+                if (clockCycleCounter < frameDivisor - 1) begin
                     clockCycleCounter <= clockCycleCounter + 1;
                 end else begin
                     clockCycleCounter <= 0;
@@ -54,7 +90,7 @@ module uart_tx #(parameter clocksPerBit = 108) (
             // Shift out 8 bits, LSB first
             stateTransmitData: begin
                 serialDataOutput <= transmitDataBuffer[bitIndexCounter];
-                if (clockCycleCounter < clocksPerBit - 1) begin
+                if (clockCycleCounter < frameDivisor - 1) begin
                     clockCycleCounter <= clockCycleCounter + 1;
                 end else begin
                     clockCycleCounter <= 0;
@@ -71,13 +107,22 @@ module uart_tx #(parameter clocksPerBit = 108) (
             // Drive line HIGH for 1 bit period (Stop Bit)
             stateTransmitStop: begin
                 serialDataOutput <= 1'b1;
-                if (clockCycleCounter < clocksPerBit - 1) begin
+                if (clockCycleCounter < frameDivisor - 1) begin
                     clockCycleCounter <= clockCycleCounter + 1;
                 end else begin
                     transmitDoneFlag   <= 1'b1;
                     clockCycleCounter  <= 0;
-                    mainStateMachine   <= stateCleanup;
-                    transmitActiveFlag <= 1'b0;
+                    if (nextByteReady) begin
+                        // Chain the queued byte: next start bit follows immediately
+                        transmitDataBuffer <= nextByte;
+                        frameDivisor       <= programmedDivisor;
+                        mainStateMachine   <= stateTransmitStart;
+                        pendingByte        <= transmitByte;
+                        pendingValid       <= pendingValid && transmitDataValid;
+                    end else begin
+                        mainStateMachine   <= stateCleanup;
+                        transmitActiveFlag <= 1'b0;
+                    end
                 end
             end
 
@@ -92,7 +137,9 @@ module uart_tx #(parameter clocksPerBit = 108) (
     end
 
     // Continuous assignments for flags
-    assign isTransmitDone   = transmitDoneFlag;
-    assign isTransmitActive = transmitActiveFlag;
+    assign isTransmitDone       = transmitDoneFlag;
+    assign isTransmitActive     = transmitActiveFlag;
+    assign isTransmitBufferFull = pendingValid;
+    assign divisorValue         = programmedDivisor;
 
-endmodule
\ No newline at end of file
+endmodule
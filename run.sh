@@ -11,7 +11,7 @@ else
 fi
 
 if [ -z "$1" ]; then
-    echo "Usage: ./run.sh <module_name>"
+    echo "Usage: ./run.sh <module_name> [+plusargs...]"
     echo "Example: ./run.sh soc_top"
     exit 1
 fi
@@ -22,28 +22,54 @@ MODULE=$1
 # 1. COMPILE FIRMWARE
 # ---------------------------------------------------------
 # Only compile firmware if we are running the top-level SoC
-if [ "$MODULE" == "soc_top" ]; then
+# TB=<name> links sim/<name>_tb.cpp instead; such benches bring their own image
+# NO_FIRMWARE=1 reuses the image already in firmware/ (sweep.sh builds it once)
+if [ "$MODULE" == "soc_top" ] && [ -z "$TB" ] && [ -z "$NO_FIRMWARE" ]; then
     echo "--- BUILDING FIRMWARE ---"
     cd firmware
     make clean > /dev/null
     
+    # The memory layout follows the model: -GROM_WORDS/-GRAM_WORDS/-GHARTS size link.ld too
+    MEMORY_SIZES=""
+    for FLAG in $VERILATOR_FLAGS; do
+        case "$FLAG" in
+            -GROM_WORDS=*|-GRAM_WORDS=*|-GHARTS=*) MEMORY_SIZES="$MEMORY_SIZES ${FLAG#-G}" ;;
+        esac
+    done
+
     # Pass the toolchain variables to Make
-    make CC="$CC" OBJCOPY="$OBJCOPY" CFLAGS="$CFLAGS" || { echo "Firmware build failed"; exit 1; }
+    # CONSOLE=host routes print_str() through the harness instead of the UART
+    # APP=<name> builds firmware/<name>.c instead of main.c (e.g. APP=bench_smp)
+    make CC="$CC" OBJCOPY="$OBJCOPY" CFLAGS="$CFLAGS" CONSOLE="${CONSOLE:-uart}" APP="${APP:-main}" $MEMORY_SIZES || { echo "Firmware build failed"; exit 1; }
     
     # --- NEW: SYMBOL TABLE DUMP ---
     # Attempt to use the cross-compiler 'nm' (e.g. riscv64-unknown-elf-nm)
     # We derive it by replacing 'gcc' with 'nm' in the CC variable.
     NM_TOOL="${CC%gcc}nm"
     
+    # The listing is also saved to firmware.sym for the harness (sim/symbol_table.h)
     echo "--- FIRMWARE SYMBOLS (DEBUG) ---"
     if command -v $NM_TOOL &> /dev/null; then
-        $NM_TOOL --numeric-sort firmware.elf | grep -v " U "
+        $NM_TOOL --numeric-sort firmware.elf | grep -v " U " | tee firmware.sym
     else
         # Fallback to system nm (might fail on some systems, but worth a try)
-        nm --numeric-sort firmware.elf | grep -v " U "
+        nm --numeric-sort firmware.elf | grep -v " U " | tee firmware.sym
     fi
     echo "--------------------------------"
 
+    # --- SOURCE LINE TABLE (PROFILER) ---
+    # One addr2line lookup per ROM word up to _text_end -> firmware.lines
+    ADDR2LINE_TOOL="${CC%gcc}addr2line"
+    command -v $ADDR2LINE_TOOL &> /dev/null || ADDR2LINE_TOOL="addr2line"
+    TEXT_END=$(awk '$3 == "_text_end" { print $1 }' firmware.sym)
+    if [ -n "$TEXT_END" ]; then
+        awk -v end=$((16#$TEXT_END)) 'BEGIN { for (a = 0; a < end; a += 4) printf "0x%08x\n", a }' \
+            | $ADDR2LINE_TOOL -a -s -e firmware.elf > firmware.lines 2> /dev/null
+
+        # Code size, for comparing MARCH=rv32iac_zba_zbb (RVC) against the default
+        echo "[SIZE] .text: $((16#$TEXT_END)) bytes (-march=$MARCH)"
+    fi
+
     cd ..
 
     echo "--- GENERATING HEX ---"
@@ -67,23 +93,36 @@ fi
 echo "--- SIMULATING $MODULE ---"
 
 # Detect the Testbench File
-# If module is soc_top, this looks for sim/soc_top_tb.cpp
-TB_FILE="sim/${MODULE}_tb.cpp"
+# If module is soc_top, this looks for sim/soc_top_tb.cpp (TB=soc_top_fuzz: sim/soc_top_fuzz_tb.cpp)
+TB_FILE="sim/${TB:-$MODULE}_tb.cpp"
 
 if [ ! -f "$TB_FILE" ]; then
     echo "Error: C++ Testbench not found at: $TB_FILE"
     exit 1
 fi
 
+# OBJ_DIR: build directory (default obj_dir), so several models can coexist
+OBJ_DIR="${OBJ_DIR:-obj_dir}"
+
 # Clean previous build artifacts
-rm -rf obj_dir
+rm -rf "$OBJ_DIR"
 rm -f *.vcd
 
+# Parameter overrides reach the harness too: -G<NAME>=<value> -> -DSOC_<NAME>=<value> (sim/soc_config.h)
+HARNESS_DEFINES=""
+for FLAG in $VERILATOR_FLAGS; do
+    case "$FLAG" in
+        -G*=*) HARNESS_DEFINES="$HARNESS_DEFINES -DSOC_${FLAG#-G}" ;;
+    esac
+done
+
 # Run Verilator
 # --cc: Generate C++ output
 # --exe: Link our custom C++ testbench
 # --trace: Enable waveform generation
-verilator --cc rtl/$MODULE.sv --exe $TB_FILE --trace -Irtl -Isim --top-module $MODULE
+# VERILATOR_FLAGS: extra options, e.g. parameter overrides (-GMEMORY_SYNC_READ=1)
+verilator --cc rtl/$MODULE.sv --exe $TB_FILE --trace -Irtl -Isim --top-module $MODULE --Mdir "$OBJ_DIR" \
+    ${HARNESS_DEFINES:+-CFLAGS "$HARNESS_DEFINES"} $VERILATOR_FLAGS
 
 if [ $? -ne 0 ]; then
     echo "Verilator compilation failed!"
@@ -91,12 +130,16 @@ if [ $? -ne 0 ]; then
 fi
 
 # Build the C++ Simulation Binary
-make -C obj_dir -f V$MODULE.mk > /dev/null
+make -C "$OBJ_DIR" -f V$MODULE.mk > /dev/null
 
-# Execute the Simulation
-if [ -f ./obj_dir/V$MODULE ]; then
+# Execute the Simulation (BUILD_ONLY=1 stops after the build)
+# The exit status is the firmware's HOST_EXIT code when it uses the host channel
+if [ -f "$OBJ_DIR/V$MODULE" ]; then
+    [ -n "$BUILD_ONLY" ] && exit 0
     echo "--- STARTING SIMULATION ---"
-    ./obj_dir/V$MODULE
+    # Extra arguments are forwarded as plusargs, e.g. ./run.sh soc_top +profile
+    "$OBJ_DIR/V$MODULE" "${@:2}"
+    exit $?
 else
     echo "Build Failed at the Make stage!"
     exit 1
@@ -0,0 +1,101 @@
+#include <iostream>
+#include "tb_framework.h"
+#include "Vaccel_crc32.h"
+
+// Default parameters: 8 bits per cycle, so crc32.b is single-cycle and
+// crc32.w takes four.
+
+#define FUNCT3_CRC32_B 0
+#define FUNCT3_CRC32_W 2
+
+// --- THE GOLDEN MODEL ---
+// Bitwise reflected CRC-32 (no table, no pre/post inversion)
+uint32_t solve_golden(uint32_t crc, uint32_t data, int bits) {
+    crc ^= (bits == 32) ? data : (data & 0xFF);
+    for (int i = 0; i < bits; i++) crc = (crc >> 1) ^ (0xEDB88320 & (0u - (crc & 1)));
+    return crc;
+}
+
+typedef Testbench<Vaccel_crc32> CrcBench;
+
+// Holds the request like the stalled core and returns the cycles to ready
+int run_step(CrcBench& tb, int funct3, uint32_t crc, uint32_t data, uint32_t* result) {
+    Vaccel_crc32* top = tb.dut();
+    top->accelValid = 1; top->accelCustom1 = 0; top->accelFunct7 = 0;
+    top->accelFunct3 = funct3; top->accelOperandA = crc; top->accelOperandB = data;
+    top->eval();
+    int cycles = 1;
+    while (!top->accelReady && cycles < 64) { tb.tick(); cycles++; }
+    *result = top->accelResult;
+    tb.tick(); // Core commits on this edge
+    top->accelValid = 0; top->eval();
+    return cycles;
+}
+
+int main(int argc, char** argv) {
+    CrcBench tb(argc, argv, "CRC32 Accelerator");
+    Vaccel_crc32* acc = tb.dut();
+
+    tb.reset();
+    tb.tick();
+
+    // ==========================================
+    // TEST 1: CHECK VALUE ("123456789" -> 0xCBF43926)
+    // ==========================================
+    const char* text = "123456789";
+    uint32_t crc = 0xFFFFFFFF, result;
+    for (int i = 0; i < 9; i++) {
+        run_step(tb, FUNCT3_CRC32_B, crc, (uint8_t)text[i], &result);
+        crc = result;
+    }
+    tb.check((crc ^ 0xFFFFFFFF) == 0xCBF43926, "crc32.b over \"123456789\" gives 0xCBF43926.",
+             "Check value wrong: " + tb_hex(crc ^ 0xFFFFFFFF));
+
+    // ==========================================
+    // TEST 2: MULTI-CYCLE HANDSHAKE
+    // ==========================================
+    uint32_t byteResult, wordResult;
+    int byteCycles = run_step(tb, FUNCT3_CRC32_B, 0x12345678, 0xAB, &byteResult);
+    int wordCycles = run_step(tb, FUNCT3_CRC32_W, 0x12345678, 0xCAFEBABE, &wordResult);
+    tb.check(byteCycles == 1 && wordCycles == 4 && wordResult == solve_golden(0x12345678, 0xCAFEBABE, 32),
+             "crc32.b ready at once, crc32.w after 4 cycles.",
+             "Handshake: byte " + std::to_string(byteCycles) + " cycles, word " + std::to_string(wordCycles) + " cycles.");
+
+    // ==========================================
+    // TEST 3: CANCELLED STEP
+    // ==========================================
+    // A trap drops accelValid mid-step; the retried instruction starts over
+    acc->accelValid = 1; acc->accelFunct3 = FUNCT3_CRC32_W;
+    acc->accelOperandA = 0xFFFFFFFF; acc->accelOperandB = 0x11111111;
+    tb.tick(2);
+    acc->accelValid = 0; tb.tick();
+    run_step(tb, FUNCT3_CRC32_W, 0x00000000, 0x87654321, &result);
+    tb.check(result == solve_golden(0x00000000, 0x87654321, 32), "Dropping accelValid abandons the step.",
+             "Stale state after cancel: " + tb_hex(result));
+
+    // ==========================================
+    // TEST 4: RANDOM VECTORS
+    // ==========================================
+    tb.vectors("Random Steps", 20000, [&](uint64_t) {
+        uint32_t c = tb.random32();
+        uint32_t d = tb.random32();
+        int word = tb.random32() & 1;
+        run_step(tb, word ? FUNCT3_CRC32_W : FUNCT3_CRC32_B, c, d, &result);
+        return result == solve_golden(c, d, word ? 32 : 8);
+    });
+
+    // ==========================================
+    // TEST 5: UNKNOWN OPERATIONS COMPLETE AT ONCE
+    // ==========================================
+    acc->accelValid = 1; acc->accelCustom1 = 1; acc->accelFunct3 = FUNCT3_CRC32_W;
+    acc->eval();
+    bool custom1Ok = acc->accelReady && acc->accelResult == 0;
+    acc->accelCustom1 = 0; acc->accelFunct7 = 1; acc->eval();
+    bool funct7Ok = acc->accelReady && acc->accelResult == 0;
+    acc->accelValid = 0; acc->accelFunct7 = 0;
+
+    tb.check(custom1Ok && funct7Ok, "Unknown encodings never stall the core.",
+             "Unknown encoding stalled or returned data.");
+
+    return tb.finish();
+}
@@ -1,73 +1,128 @@
 
 
 #include <iostream>
-#include <cstdlib>     // For rand()
-#include <verilated.h> // Core Verilator routine
+#include <vector>
+#include "tb_framework.h"
 #include "Valu.h"      // Generated header from your SystemVerilog
 
 // --- THE GOLDEN MODEL ---
 // This function mimics exactly what the hardware *should* do in C++.
 // We use this to verify the hardware result.
+#define ALU_OP_COUNT 30
+
+static uint32_t rotl(uint32_t v, uint32_t n) { n &= 31; return n ? (v << n) | (v >> (32 - n)) : v; }
+static uint32_t rotr(uint32_t v, uint32_t n) { n &= 31; return n ? (v >> n) | (v << (32 - n)) : v; }
+
 uint32_t solve_golden(uint32_t a, uint32_t b, int op) {
+    int32_t sa = (int32_t)a, sb = (int32_t)b;
     switch(op) {
         case 0: return a + b;       // 000: ADD
         case 1: return a - b;       // 001: SUB
         case 2: return a & b;       // 010: AND
         case 3: return a | b;       // 011: OR
         case 4: return a ^ b;       // 100: XOR
-        case 5: return (a < b) ? 1 : 0; // 101: SLT
+        case 5: return (sa < sb) ? 1 : 0; // 101: SLT
+        case 6:  return a & ~b;                       // ANDN
+        case 7:  return a | ~b;                       // ORN
+        case 8:  return ~(a ^ b);                     // XNOR
+        case 9:  return a ? __builtin_clz(a) : 32;    // CLZ
+        case 10: return a ? __builtin_ctz(a) : 32;    // CTZ
+        case 11: return __builtin_popcount(a);        // CPOP
+        case 12: return rotl(a, b);                   // ROL
+        case 13: return rotr(a, b);                   // ROR
+        case 14: return (sa < sb) ? a : b;            // MIN
+        case 15: return (sa < sb) ? b : a;            // MAX
+        case 16: return (a < b) ? a : b;              // MINU
+        case 17: return (a < b) ? b : a;              // MAXU
+        case 18: return (a << 1) + b;                 // SH1ADD
+        case 19: return (a << 2) + b;                 // SH2ADD
+        case 20: return (a << 3) + b;                 // SH3ADD
+        case 21: return __builtin_bswap32(a);         // REV8
+        case 22: {                                    // ORC.B
+            uint32_t r = 0;
+            for (int i = 0; i < 32; i += 8) if ((a >> i) & 0xFF) r |= 0xFFu << i;
+            return r;
+        }
+        case 23: return (uint32_t)(int32_t)(int8_t)a;  // SEXT.B
+        case 24: return (uint32_t)(int32_t)(int16_t)a; // SEXT.H
+        case 25: return a & 0xFFFF;                   // ZEXT.H
+        case 26: return (a < b) ? 1 : 0;              // SLTU
+        case 27: return a << (b & 31);                // SLL
+        case 28: return a >> (b & 31);                // SRL
+        case 29: return (uint32_t)(sa >> (b & 31));   // SRA
         default: return 0;
     }
 }
 
-int main(int argc, char** argv) {
-    Verilated::commandArgs(argc, argv);
-    
-    // Instantiate the ALU
-    Valu* alu = new Valu;
-
-    // Simulation Parameters
-    const int NUM_TESTS = 100000; // Check 100k vectors
-    int success_count = 0;
-
-    std::cout << "[TEST] Starting ALU Verification (100,000 Vectors)...\n";
+// Drives one vector and compares against the golden model
+bool check(Valu* alu, uint32_t a, uint32_t b, int op, const char* phase) {
+    alu->inputA = a;
+    alu->inputB = b;
+    alu->aluControl = op;
+    alu->eval();
 
-    for (int i = 0; i < NUM_TESTS; i++) {
-        // 1. Generate Random Inputs
-        // Use 32-bit random numbers (rand() is usually 15-bit, so we shift/mix)
-        uint32_t a = (rand() << 16) | rand();
-        uint32_t b = (rand() << 16) | rand();
-        int op = rand() % 6; // Valid ops are 0-5
+    uint32_t expected_result = solve_golden(a, b, op);
+    bool expected_zero = (expected_result == 0);
+    if ((alu->aluResult != expected_result) || (alu->zero != expected_zero)) {
+        std::cout << "\n[FAIL] Mismatch Detected (" << phase << ")\n";
+        std::cout << "  OPCODE: " << std::dec << op << "\n";
+        std::cout << "  Input A: 0x" << std::hex << a << "\n";
+        std::cout << "  Input B: 0x" << std::hex << b << "\n";
+        std::cout << "  Expected: 0x" << expected_result << " (Zero: " << expected_zero << ")\n";
+        std::cout << "  Actual:   0x" << alu->aluResult << " (Zero: " << (int)alu->zero << ")\n" << std::dec;
+        return false;
+    }
+    return true;
+}
 
-        // 2. Drive the Hardware Inputs
-        alu->inputA = a;
-        alu->inputB = b;
-        alu->aluControl = op;
-        
-        // 3. Evaluate (Run one cycle of logic)
-        alu->eval();
+int main(int argc, char** argv) {
+    Testbench<Valu> tb(argc, argv, "ALU");
+    Valu* alu = tb.dut();
 
-        // 4. Compute Expected Result (Golden Model)
-        uint32_t expected_result = solve_golden(a, b, op);
-        bool expected_zero = (expected_result == 0);
+    // Random vectors: 100k operand pairs over every op
+    tb.vectors("Random Vectors", 100000, [&](uint64_t) {
+        uint32_t a = tb.random32();
+        uint32_t b = tb.random32();
+        int op = tb.random(ALU_OP_COUNT);
+        return check(alu, a, b, op, "random");
+    });
 
-        // 5. Compare Hardware vs Software
-        if ((alu->aluResult != expected_result) || (alu->zero != expected_zero)) {
-            std::cout << "\n[FAIL] Mismatch Detected at Test #" << i << "\n";
-            std::cout << "  OPCODE: " << op << "\n";
-            std::cout << "  Input A: 0x" << std::hex << a << "\n";
-            std::cout << "  Input B: 0x" << std::hex << b << "\n";
-            std::cout << "  Expected: 0x" << expected_result << " (Zero: " << expected_zero << ")\n";
-            std::cout << "  Actual:   0x" << alu->aluResult << " (Zero: " << (int)alu->zero << ")\n";
-            
-            delete alu;
-            return 1; // Exit with error code
-        }
+    // Edge operands: every op against every pair of boundary values and
+    // single-bit patterns (sign bit, byte/halfword boundaries, all shifts)
+    std::vector<uint32_t> edges = {0x00000000, 0x00000001, 0xFFFFFFFF, 0x7FFFFFFF, 0x80000000,
+                                   0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x0000FFFF,
+                                   0xFFFF0000, 0x00000080, 0x00008000, 0x12345678, 0xDEADBEEF};
+    for (int bit = 0; bit < 32; bit++) {
+        edges.push_back(1u << bit);
+        edges.push_back(~(1u << bit));
+        edges.push_back(0xFFFFFFFFu >> bit);
     }
+    const uint64_t pairs = edges.size() * edges.size();
+    tb.vectors("Edge Vectors", ALU_OP_COUNT * pairs, [&](uint64_t index) {
+        return check(alu, edges[(index % pairs) / edges.size()], edges[index % edges.size()],
+                     (int)(index / pairs), "edge");
+    });
+
+    // Exhaustive over the byte/halfword domains of the unary ops and every
+    // rotate and shift amount (upper B bits must be ignored)
+    static const int unaryOps[] = {9, 10, 11, 21, 22, 23, 24, 25};
+    tb.vectors("Unary Sweep", 0x10000 * 8, [&](uint64_t index) {
+        uint32_t v = (uint32_t)(index >> 3);
+        uint32_t a = (v | (v << 16)) ^ 0xA5A50000;
+        int op = unaryOps[index & 7];
+        return check(alu, v, 0, op, "unary") && check(alu, a, 0, op, "unary");
+    });
+    tb.vectors("Rotate Sweep", 64 * edges.size(), [&](uint64_t index) {
+        uint32_t shamt = (uint32_t)(index / edges.size());
+        uint32_t a     = edges[index % edges.size()];
+        return check(alu, a, shamt | 0xFFFFFFC0, 12, "rotate") && check(alu, a, shamt, 13, "rotate");
+    });
+    tb.vectors("Shift Sweep", 64 * edges.size(), [&](uint64_t index) {
+        uint32_t shamt = (uint32_t)(index / edges.size());
+        uint32_t a     = edges[index % edges.size()];
+        return check(alu, a, shamt | 0xFFFFFFC0, 27, "shift") && check(alu, a, shamt, 28, "shift") &&
+               check(alu, a, shamt ^ 0x80000000, 29, "shift");
+    });
 
-    // If we get here, we survived 100,000 tests
-    std::cout << "[PASS] ALU Integrity Verified. 100,000 vectors matched.\n";
-    
-    delete alu;
-    return 0;
-}
\ No newline at end of file
+    return tb.finish();
+}
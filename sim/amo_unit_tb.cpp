@@ -0,0 +1,77 @@
+#include <iostream>
+#include "tb_framework.h"
+#include "Vamo_unit.h"
+
+// --- AMO FUNCT5 ENCODINGS (instruction[31:27]) ---
+#define AMO_ADD  0x00
+#define AMO_SWAP 0x01
+#define AMO_XOR  0x04
+#define AMO_OR   0x08
+#define AMO_AND  0x0C
+#define AMO_MIN  0x10
+#define AMO_MAX  0x14
+#define AMO_MINU 0x18
+#define AMO_MAXU 0x1C
+
+// --- THE GOLDEN MODEL ---
+// Value written back to memory for old word 'm' and rs2 'v'
+uint32_t solve_golden(uint32_t m, uint32_t v, int funct5) {
+    int32_t sm = (int32_t)m, sv = (int32_t)v;
+    switch (funct5) {
+        case AMO_SWAP: return v;
+        case AMO_ADD:  return m + v;
+        case AMO_XOR:  return m ^ v;
+        case AMO_AND:  return m & v;
+        case AMO_OR:   return m | v;
+        case AMO_MIN:  return (sm < sv) ? m : v;
+        case AMO_MAX:  return (sm < sv) ? v : m;
+        case AMO_MINU: return (m < v) ? m : v;
+        case AMO_MAXU: return (m < v) ? v : m;
+        default:       return m;
+    }
+}
+
+// Drives one operation and compares the store value against the golden model
+bool check(Vamo_unit* amo, uint32_t m, uint32_t v, int op, const char* phase) {
+    amo->amoFunct5 = op; amo->memoryValue = m; amo->operandValue = v;
+    amo->eval();
+    if (amo->storeValue == solve_golden(m, v, op)) return true;
+    std::cout << "[FAIL] " << phase << " mismatch: funct5=0x" << std::hex << op << " mem=0x" << m
+              << " rs2=0x" << v << " got 0x" << amo->storeValue << std::dec << "\n";
+    return false;
+}
+
+int main(int argc, char** argv) {
+    Testbench<Vamo_unit> tb(argc, argv, "AMO Unit");
+    Vamo_unit* amo = tb.dut();
+
+    const int ops[] = {AMO_ADD, AMO_SWAP, AMO_XOR, AMO_OR, AMO_AND, AMO_MIN, AMO_MAX, AMO_MINU, AMO_MAXU};
+    const uint32_t edges[] = {0x00000000, 0x00000001, 0xFFFFFFFF, 0x7FFFFFFF, 0x80000000, 0x12345678};
+
+    // ==========================================
+    // TEST 1: SIGNED/UNSIGNED BOUNDARIES
+    // ==========================================
+    tb.vectors("Boundary Vectors (MIN/MAX sign handling)", 9 * 6 * 6, [&](uint64_t index) {
+        return check(amo, edges[(index / 6) % 6], edges[index % 6], ops[index / 36], "Boundary");
+    });
+
+    // ==========================================
+    // TEST 2: RANDOM VECTORS
+    // ==========================================
+    tb.vectors("Random Vectors", 100000, [&](uint64_t) {
+        uint32_t m = tb.random32();
+        uint32_t v = tb.random32();
+        return check(amo, m, v, ops[tb.random(9)], "Random");
+    });
+
+    // ==========================================
+    // TEST 3: UNKNOWN FUNCT5 IS HARMLESS
+    // ==========================================
+    // LR/SC encodings (0x02/0x03) never use the unit; anything unknown writes back the old word
+    amo->amoFunct5 = 0x02; amo->memoryValue = 0xCAFEBABE; amo->operandValue = 0x11111111;
+    amo->eval();
+    tb.check(amo->storeValue == 0xCAFEBABE, "Unknown funct5 writes back memory unchanged.",
+             "Unknown funct5 modified memory.");
+
+    return tb.finish();
+}
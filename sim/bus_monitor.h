@@ -0,0 +1,65 @@
+#ifndef BUS_MONITOR_H
+#define BUS_MONITOR_H
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include "Vsoc_top.h"
+#include "Vsoc_top___024root.h"
+
+// Counter indices (must match bus_interconnect.sv section 6)
+enum BusCounter {
+    BUS_CPU_READS, BUS_CPU_WRITES, BUS_CPU_STALLS,
+    BUS_DMA_READS, BUS_DMA_WRITES, BUS_DMA_STALLS,
+    BUS_ROM_READS, BUS_RAM_READS, BUS_RAM_WRITES,
+    BUS_IO_READS,  BUS_IO_WRITES,
+    BUS_BUSY_CYCLES, BUS_CYCLES,   BUS_HART_STALLS,
+    BUS_READ_BYTES,  BUS_WRITE_BYTES,
+    BUS_COUNTER_COUNT
+};
+
+/**
+ * @brief Samples the bus_interconnect counters every 'interval' CPU cycles
+ * and prints per-interval bandwidth. Reads the counters directly, so it
+ * adds no bus traffic of its own.
+ */
+class BusMonitor {
+public:
+    BusMonitor(Vsoc_top *dut, uint64_t interval) : dut(dut), interval(interval) {}
+
+    void onCycle(uint64_t cycle) {
+        if (!interval || cycle % interval) return;
+        uint32_t now[BUS_COUNTER_COUNT];
+        for (int i = 0; i < BUS_COUNTER_COUNT; i++) now[i] = dut->rootp->soc_top__DOT__u_bus__DOT__perfCounters[i];
+
+        if (!headerPrinted) {
+            std::cout << "\n[BUS]  end-cycle  util%  cpuR  cpuW  stall  hartW  romR  ramR  ramW   ioR   ioW  B/cycle" << std::endl;
+            headerPrinted = true;
+        }
+        // Unsigned deltas survive counter wrap and firmware clears mid-interval
+        uint32_t delta[BUS_COUNTER_COUNT];
+        for (int i = 0; i < BUS_COUNTER_COUNT; i++) delta[i] = now[i] - last[i];
+        uint32_t window = delta[BUS_CYCLES] ? delta[BUS_CYCLES] : 1;
+        uint32_t bytes  = delta[BUS_READ_BYTES] + delta[BUS_WRITE_BYTES]; // Byte lanes used, not 4 per access
+
+        std::cout << "[BUS] " << std::setw(10) << cycle
+                  << std::fixed << std::setprecision(1) << std::setw(7) << 100.0 * delta[BUS_BUSY_CYCLES] / window
+                  << std::setw(6) << delta[BUS_CPU_READS] << std::setw(6) << delta[BUS_CPU_WRITES]
+                  << std::setw(7) << delta[BUS_CPU_STALLS] + delta[BUS_DMA_STALLS]
+                  << std::setw(7) << delta[BUS_HART_STALLS]
+                  << std::setw(6) << delta[BUS_ROM_READS] << std::setw(6) << delta[BUS_RAM_READS]
+                  << std::setw(6) << delta[BUS_RAM_WRITES] << std::setw(6) << delta[BUS_IO_READS]
+                  << std::setw(6) << delta[BUS_IO_WRITES]
+                  << std::setw(9) << std::setprecision(2) << (double)bytes / window << std::endl;
+
+        for (int i = 0; i < BUS_COUNTER_COUNT; i++) last[i] = now[i];
+    }
+
+private:
+    Vsoc_top *dut;
+    uint64_t  interval;
+    uint32_t  last[BUS_COUNTER_COUNT] = {};
+    bool      headerPrinted = false;
+};
+
+#endif
@@ -1,42 +1,39 @@
 #include <iostream>
-#include <verilated.h>
+#include "tb_framework.h"
 #include "Vdata_mem.h"
 
-// Helper to step the clock
-void tick(Vdata_mem* top) {
-    top->clock = 0; top->eval();
-    top->clock = 1; top->eval(); // Write happens on Rising Edge
+typedef Testbench<Vdata_mem> DataMemBench;
+
+// Presents a read address and clocks it in. With syncRead=0 the tick is a
+// no-op for the read path, so the same checks cover both RAM variants.
+void read_at(DataMemBench& tb, uint32_t address) {
+    tb->ramAxiReadAddress = address;
+    tb.tick();
 }
 
 int main(int argc, char** argv) {
-    Verilated::commandArgs(argc, argv);
-    Vdata_mem* ram = new Vdata_mem;
-
-    std::cout << "[TEST] Starting Data RAM Verification...\n";
+    DataMemBench tb(argc, argv, "Data RAM");
+    Vdata_mem* ram = tb.dut();
 
     // ==========================================
     // TEST 1: BASIC READ/WRITE
     // ==========================================
-    // Write 0xDEADBEEF to Address 0x100
+    // Write 0xDEADBEEF to Address 0x100 (all four byte lanes)
+    ram->ramAxiWriteStrobe = 0xF;
     ram->ramAxiWriteValid = 1;
     ram->ramAxiWriteAddress = 0x00000100;
     ram->ramAxiWriteData    = 0xDEADBEEF;
     
-    tick(ram); // Trigger Write
+    tb.tick(); // Trigger Write (writes happen on the rising edge)
 
     // Disable Write
     ram->ramAxiWriteValid = 0;
     
     // Read Address 0x100
-    ram->ramAxiReadAddress = 0x00000100;
-    ram->eval(); // Update combinational read logic
-
-    if (ram->ramAxiReadData == 0xDEADBEEF) {
-        std::cout << "[PASS] Basic Read/Write Verified.\n";
-    } else {
-        std::cout << "[FAIL] Write Failed. Expected DEADBEEF, Got: " << std::hex << ram->ramAxiReadData << "\n";
-        return 1;
-    }
+    read_at(tb, 0x00000100);
+
+    tb.check(ram->ramAxiReadData == 0xDEADBEEF, "Basic Read/Write Verified.",
+             "Write Failed. Expected DEADBEEF, Got: " + tb_hex(ram->ramAxiReadData));
 
     // ==========================================
     // TEST 2: WORD ALIGNMENT (CRITICAL)
@@ -49,20 +46,15 @@ int main(int argc, char** argv) {
     ram->ramAxiWriteValid = 1;
     ram->ramAxiWriteAddress = 0x00000004; // Address 4
     ram->ramAxiWriteData    = 0xCAFEBABE;
-    tick(ram);
+    tb.tick();
 
     // Now Read back using a misaligned address (0x00000006)
     // If your logic [11:2] works, this should still read index 1.
     ram->ramAxiWriteValid = 0;
-    ram->ramAxiReadAddress = 0x00000006; 
-    ram->eval();
-
-    if (ram->ramAxiReadData == 0xCAFEBABE) {
-        std::cout << "[PASS] Word Alignment Verified (Address 0x4 == 0x6).\n";
-    } else {
-        std::cout << "[FAIL] Word Alignment Failed! 0x4 and 0x6 treated as different words.\n";
-        return 1;
-    }
+    read_at(tb, 0x00000006);
+
+    tb.check(ram->ramAxiReadData == 0xCAFEBABE, "Word Alignment Verified (Address 0x4 == 0x6).",
+             "Word Alignment Failed! 0x4 and 0x6 treated as different words.");
 
     // ==========================================
     // TEST 3: WRITE PROTECTION
@@ -74,23 +66,18 @@ int main(int argc, char** argv) {
     ram->ramAxiWriteValid = 1;
     ram->ramAxiWriteAddress = 0x00000200;
     ram->ramAxiWriteData    = 0x11111111;
-    tick(ram);
+    tb.tick();
 
     // 2. Try to Overwrite with 0xFFFFFFFF but Valid = 0
     ram->ramAxiWriteValid = 0; // DISABLE WRITE
     ram->ramAxiWriteData    = 0xFFFFFFFF;
-    tick(ram);
+    tb.tick();
 
     // 3. Read Back
-    ram->ramAxiReadAddress = 0x00000200;
-    ram->eval();
-
-    if (ram->ramAxiReadData == 0x11111111) {
-        std::cout << "[PASS] Write Protection Verified (Data preserved when Valid=0).\n";
-    } else {
-        std::cout << "[FAIL] Write Protection Failed! RAM was overwritten without Valid signal.\n";
-        return 1;
-    }
+    read_at(tb, 0x00000200);
+
+    tb.check(ram->ramAxiReadData == 0x11111111, "Write Protection Verified (Data preserved when Valid=0).",
+             "Write Protection Failed! RAM was overwritten without Valid signal.");
 
     // ==========================================
     // TEST 4: ADDRESS BOUNDARIES
@@ -101,33 +88,81 @@ int main(int argc, char** argv) {
     // Write 0xAAAA at Address 0
     ram->ramAxiWriteAddress = 0x00000000;
     ram->ramAxiWriteData    = 0xAAAAAAAA;
-    tick(ram);
+    tb.tick();
 
     // Write 0xBBBB at Address 4
     ram->ramAxiWriteAddress = 0x00000004;
     ram->ramAxiWriteData    = 0xBBBBBBBB;
-    tick(ram);
+    tb.tick();
+
+    ram->ramAxiWriteValid = 0;
 
     // Read 0
-    ram->ramAxiReadAddress = 0x00000000;
-    ram->eval();
+    read_at(tb, 0x00000000);
     bool val0_ok = (ram->ramAxiReadData == 0xAAAAAAAA);
 
     // Read 4
-    ram->ramAxiReadAddress = 0x00000004;
-    ram->eval();
+    read_at(tb, 0x00000004);
     bool val4_ok = (ram->ramAxiReadData == 0xBBBBBBBB);
 
-    if (val0_ok && val4_ok) {
-        std::cout << "[PASS] Address Space Isolation Verified (Addr 0 and 4 are distinct).\n";
-    } else {
-        std::cout << "[FAIL] Address Overlap Detected!\n";
-        return 1;
-    }
+    tb.check(val0_ok && val4_ok, "Address Space Isolation Verified (Addr 0 and 4 are distinct).",
+             "Address Overlap Detected!");
 
-    std::cout << "------------------------------------------\n";
-    std::cout << "[SUCCESS] Data RAM Verified.\n";
+    // ==========================================
+    // TEST 5: BYTE STROBES (SB/SH)
+    // ==========================================
+    // Only the lanes whose strobe bit is set change; the data is already
+    // shifted into its lane by the core.
+    ram->ramAxiWriteValid   = 1;
+    ram->ramAxiWriteAddress = 0x00000300;
+    ram->ramAxiWriteData    = 0x11223344;
+    tb.tick();
+    ram->ramAxiWriteStrobe  = 0x4;          // SB to byte 2
+    ram->ramAxiWriteData    = 0x00AA0000;
+    tb.tick();
+    ram->ramAxiWriteStrobe  = 0x3;          // SH to bytes 0-1
+    ram->ramAxiWriteData    = 0x0000BEEF;
+    tb.tick();
+    ram->ramAxiWriteValid   = 0;
+    ram->ramAxiWriteStrobe  = 0xF;
+    read_at(tb, 0x00000300);
+
+    tb.check(ram->ramAxiReadData == 0x11AABEEF, "Byte Strobes Verified (SB/SH merge into the word).",
+             "Byte Strobes Failed. Expected 11AABEEF, Got: " + tb_hex(ram->ramAxiReadData));
 
-    delete ram;
-    return 0;
+    // ==========================================
+    // TEST 6: RANDOM TRAFFIC AGAINST A SHADOW COPY
+    // ==========================================
+    // One random write (or none, with random byte lanes) and one random read
+    // per cycle over all 1024 words, checked against a C++ copy of the array. When the read
+    // hits the word just written, a registered read returns the old value
+    // and a combinational one the new value, so either is accepted.
+    static uint32_t shadow[1024];
+    ram->ramAxiWriteValid = 1;
+    for (uint32_t index = 0; index < 1024; index++) {
+        ram->ramAxiWriteAddress = index << 2;
+        ram->ramAxiWriteData    = 0;
+        tb.tick();
+    }
+    tb.vectors("Random Read/Write Traffic", 200000, [&](uint64_t) {
+        uint32_t control = tb.random32();
+        uint32_t write   = (control >> 1) & 1023;
+        uint32_t read    = (control >> 11) & 1023;
+        uint32_t strobe  = (control >> 23) & 0xF;
+        uint32_t mask    = 0;
+        for (int lane = 0; lane < 4; lane++) if (strobe & (1u << lane)) mask |= 0xFFu << (lane * 8);
+        ram->ramAxiWriteValid   = control & 1;
+        ram->ramAxiWriteAddress = (write << 2) | ((control >> 21) & 3);
+        ram->ramAxiWriteData    = tb.random32();
+        ram->ramAxiWriteStrobe  = strobe;
+        ram->ramAxiReadAddress  = read << 2;
+        uint32_t expected = shadow[read];
+        tb.tick();
+        if (control & 1) shadow[write] = (shadow[write] & ~mask) | (ram->ramAxiWriteData & mask);
+        ram->ramAxiWriteValid = 0;
+        ram->eval();
+        return ram->ramAxiReadData == expected || ram->ramAxiReadData == shadow[read];
+    });
+
+    return tb.finish();
 }
\ No newline at end of file
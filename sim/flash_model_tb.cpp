@@ -0,0 +1,77 @@
+#include <iostream>
+#include <fstream>
+#include "tb_framework.h"
+#include "Vflash_model.h"
+
+// Default parameters: 4-word lines, 8 cycles to the first word
+const int LINE_WORDS   = 4;
+const int LINE_LATENCY = 8 + LINE_WORDS - 1;
+
+// --- HELPER: CREATE DUMMY FIRMWARE ---
+// Word i of the image holds 0x1000 + i.
+void create_dummy_firmware() {
+    system("mkdir -p firmware");
+    std::ofstream outfile("firmware/firmware.hex");
+    for (int i = 0; i < 64; i++) outfile << std::hex << (0x1000 + i) << "\n";
+    outfile.close();
+    std::cout << "[SETUP] Created dummy firmware/firmware.hex\n";
+}
+
+int main(int argc, char** argv) {
+    create_dummy_firmware();
+    Testbench<Vflash_model> tb(argc, argv, "Flash Model");
+    Vflash_model* flash = tb.dut();
+
+    tb.reset();
+
+    // ==========================================
+    // TEST 1: LINE READ LATENCY
+    // ==========================================
+    // Unaligned address 0x28 lies in the line starting at word 8
+    flash->lineRequestValid   = 1;
+    flash->lineRequestAddress = 0x28;
+    tb.tick();
+    flash->lineRequestValid   = 0;
+
+    int cycles = 0;
+    while (!flash->lineResponseValid && cycles < 100) { tb.tick(); cycles++; }
+
+    tb.check(cycles == LINE_LATENCY, "Latency: Line returned after " + std::to_string(cycles) + " cycles.",
+             "Expected " + std::to_string(LINE_LATENCY) + " cycles, got " + std::to_string(cycles) + ".");
+
+    // ==========================================
+    // TEST 2: LINE CONTENTS (ALIGNED TO LINE START)
+    // ==========================================
+    bool dataOk = true;
+    for (int i = 0; i < LINE_WORDS; i++) {
+        if (flash->lineResponseData[i] != (uint32_t)(0x1000 + 8 + i)) dataOk = false;
+    }
+    tb.check(dataOk, "Line Data: Words 8..11 returned in order.",
+             "Line Data mismatch.");
+
+    // ==========================================
+    // TEST 3: SINGLE OUTSTANDING REQUEST
+    // ==========================================
+    flash->lineRequestValid = 1;
+    flash->lineRequestAddress = 0x0;
+    tb.tick();
+    bool busyOk = (flash->lineRequestReady == 0);
+    flash->lineRequestAddress = 0x40; // Must be ignored while busy
+    tb.tick();
+    flash->lineRequestValid = 0;
+    while (!flash->lineResponseValid) tb.tick();
+
+    tb.check(busyOk && flash->lineResponseData[0] == 0x1000,
+             "Busy Handling: Second request ignored during a read.",
+             "Busy Handling: Request accepted while busy.");
+
+    // ==========================================
+    // TEST 4: DATA BUS PORT
+    // ==========================================
+    flash->busReadAddress = 0x0C;
+    flash->eval();
+    tb.check(flash->busReadData == 0x1003, "Bus Port: Combinational constant read correct.",
+             "Bus Port: Got " + tb_hex(flash->busReadData));
+
+    return tb.finish();
+}
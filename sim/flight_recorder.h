@@ -0,0 +1,161 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "rv32_disasm.h"
+#include "symbol_table.h"
+
+/**
+ * @brief Post-mortem ring of hart 0's most recent commits.
+ * Recording is a handful of stores into a preallocated ring per commit,
+ * so it stays on even for runs far too long to dump a VCD. The ring is
+ * disassembled only when something goes wrong: a failed firmware
+ * assertion, a hang (no new PC for too long) or control flow leaving the
+ * firmware image. Interrupt handlers do not count as progress for the hang
+ * check, and neither does returning from one to the PC it interrupted, so
+ * a spin that the timer keeps interrupting is still caught, as is a
+ * handler that never returns. The idle task's 'while (1);' in kernel_start
+ * is the one spin that is expected, and it always counts as progress.
+ */
+class FlightRecorder {
+public:
+    struct Entry {
+        uint64_t cycle;
+        uint32_t pc;
+        uint32_t instruction;
+        uint32_t registerData;  // Value written to rd
+        uint32_t busAddress;
+        uint32_t busData;       // Store data
+        uint8_t  flags;
+    };
+
+    enum : uint8_t {
+        RegisterWrite = 1 << 0,
+        BusRead       = 1 << 1,
+        BusWrite      = 1 << 2,
+        Trap          = 1 << 3, // Interrupt taken instead of this instruction (registerData = vector)
+    };
+
+    // capacity is rounded up to a power of two; hangCycles = 0 disables the hang check
+    FlightRecorder(const SymbolTable &symbols, size_t capacity, uint64_t hangCycles)
+        : symbols(symbols), hangCycles(hangCycles) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        ring.resize(size);
+        textEnd = symbols.address("_text_end", 0x1000);
+        uint32_t kernelStart = symbols.address("kernel_start");
+        idleFunction = (kernelStart == 0xFFFFFFFF) ? nullptr : symbols.function(kernelStart);
+    }
+
+    // Hart 0 committed an instruction. Returns false once control flow has
+    // diverged (the ring is dumped first).
+    bool onRetire(uint64_t cycle, uint32_t pc, uint32_t instruction, bool registerWrite, uint32_t registerData,
+                  bool busRead, bool busWrite, uint32_t busAddress, uint32_t busData) {
+        record(cycle, pc, instruction, registerData, busAddress, busData,
+               (registerWrite ? RegisterWrite : 0) | (busRead ? BusRead : 0) | (busWrite ? BusWrite : 0));
+        if (!inImage(cycle, pc)) return false;
+
+        if (instruction == RV_MRET && trapDepth) {
+            trapDepth--;
+        } else if (!trapDepth) {
+            if (pc != lastPc || isIdleLoop(pc, instruction)) progressCycle = cycle;
+            lastPc = pc;
+        }
+        return true;
+    }
+
+    // Hart 0 took an interrupt instead of executing pc
+    bool onTrap(uint64_t cycle, uint32_t pc, uint32_t vector) {
+        record(cycle, pc, 0, vector, 0, 0, Trap);
+        trapDepth++;
+        return inImage(cycle, pc);
+    }
+
+    // Cheap enough to call every CPU cycle: it also catches a core that
+    // stops committing altogether. Returns false on a hang.
+    bool check(uint64_t cycle) {
+        if (!hangCycles || cycle - progressCycle < hangCycles) return true;
+        dump(cycle, "hang: no progress outside interrupt handlers for " + std::to_string(hangCycles) +
+                    " cycles, last PC 0x" + hex(lastPc) + " (" + symbols.functionName(lastPc) + ")");
+        return false;
+    }
+
+    // Oldest entry first
+    void dump(uint64_t cycle, const std::string &reason) const {
+        size_t count = written < ring.size() ? written : ring.size();
+        std::cout << "\n\033[1;31m[FLIGHT] " << reason << " at cycle " << std::dec << cycle << "\033[0m" << std::endl;
+        std::cout << "[FLIGHT] Last " << count << " commits (of " << written << "):" << std::endl;
+
+        for (uint64_t index = written - count; index < written; index++) {
+            const Entry &entry = ring[index & (ring.size() - 1)];
+            std::string location = symbols.functionName(entry.pc);
+            const SymbolTable::Symbol *symbol = symbols.function(entry.pc);
+            if (symbol) location += "+0x" + hex(entry.pc - symbol->address, 0);
+
+            std::cout << "[FLIGHT] " << std::dec << std::setw(9) << entry.cycle << "  "
+                      << std::hex << std::setfill('0') << std::setw(8) << entry.pc << "  "
+                      << std::setw(8) << entry.instruction << std::setfill(' ') << "  "
+                      << std::left << std::setw(22) << location.substr(0, 22) << " "
+                      << std::setw(30) << ((entry.flags & Trap) ? "" : rv32_disasm(entry.instruction, entry.pc))
+                      << std::right;
+            if (entry.flags & Trap) {
+                std::cout << " <interrupt taken, vector 0x" << hex(entry.registerData) << ">";
+            } else {
+                if (entry.flags & RegisterWrite)
+                    std::cout << " " << RV_ABI_NAMES[RV_RD(entry.instruction)] << "=0x" << hex(entry.registerData);
+                if (entry.flags & BusRead)  std::cout << " R[0x" << hex(entry.busAddress) << "]";
+                if (entry.flags & BusWrite) std::cout << " W[0x" << hex(entry.busAddress) << "]=0x" << hex(entry.busData);
+            }
+            std::cout << std::dec << std::endl;
+        }
+    }
+
+private:
+    void record(uint64_t cycle, uint32_t pc, uint32_t instruction, uint32_t registerData,
+                uint32_t busAddress, uint32_t busData, uint8_t flags) {
+        Entry &entry       = ring[written & (ring.size() - 1)];
+        entry.cycle        = cycle;
+        entry.pc           = pc;
+        entry.instruction  = instruction;
+        entry.registerData = registerData;
+        entry.busAddress   = busAddress;
+        entry.busData      = busData;
+        entry.flags        = flags;
+        written++;
+    }
+
+    // The idle task's self-jump ('j .') inside kernel_start
+    bool isIdleLoop(uint32_t pc, uint32_t instruction) const {
+        return instruction == RV_J_SELF && idleFunction && symbols.function(pc) == idleFunction;
+    }
+
+    // Divergence: the PC left the firmware image or lost its alignment
+    bool inImage(uint64_t cycle, uint32_t pc) const {
+        if (pc < textEnd && !(pc & 1)) return true;
+        dump(cycle, "divergence: PC 0x" + hex(pc) + " is outside .text (ends at 0x" + hex(textEnd) + ")");
+        return false;
+    }
+
+    static std::string hex(uint32_t value, int width = 8) {
+        std::ostringstream text;
+        text << std::hex << std::setfill('0') << std::setw(width) << value;
+        return text.str();
+    }
+
+    const SymbolTable &symbols;
+    std::vector<Entry> ring;
+    uint64_t written     = 0;
+    uint64_t hangCycles;
+    uint32_t textEnd;
+    const SymbolTable::Symbol *idleFunction;   // kernel_start, or nullptr without the kernel
+    uint32_t trapDepth     = 0;
+    uint32_t lastPc        = 0xFFFFFFFF;
+    uint64_t progressCycle = 0;
+};
+
+#endif
@@ -0,0 +1,241 @@
+#ifndef FUZZ_PROGRAM_H
+#define FUZZ_PROGRAM_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "rv32_encoding.h"
+
+// --- FUZZ MEMORY MAP ---
+// The boot stub (FuzzProgram::bootStub) parks the core in a loop that polls
+// FUZZ_MAILBOX and jumps to the address stored there.
+#define FUZZ_PARK_PC      0x00000014              // lw of the mailbox poll loop
+#define FUZZ_PROGRAM_BASE 0x00000100              // Generated program, up to the end of the ROM
+#define FUZZ_MAILBOX      0x20000000              // RAM word 0
+#define FUZZ_RAM_POINTER  0x20000800              // x31: every RAM word is within +-2 KiB
+#define FUZZ_DUMP_OFFSET  0x780                   // x1..x29 are stored at x31 + 0x780 + 4 * n on exit
+#define FUZZ_MMIO_POINTER 0x40000000              // x30
+#define FUZZ_EXIT_OFFSET  0x104                   // HOST_EXIT relative to x30
+
+/**
+ * @brief Constrained-random RV32I program for differential runs of Vsoc_top.
+ * The generator emits only what the core implements architecturally:
+ *   - LUI, AUIPC, the RV32I OP-IMM and OP instructions (shifts and SLT*
+ *     included), plus Zba/Zbb;
+ *   - every load and store width on the RAM window (x31-relative), loads
+ *     from the ROM (x0-relative), naturally aligned;
+ *   - RV32A on RAM words, all six branch conditions, JAL, JALR;
+ *   - the side-effect-free MMIO registers (UART data/divisor, MHARTID, hart count).
+ * Misaligned accesses, FENCE, ECALL/EBREAK and CSR instructions are left
+ * out: the core does not implement them, and a program that used them
+ * would fail on known gaps rather than find new bugs.
+ * Control flow only goes forward to a sequence boundary, so every program
+ * terminates. The prologue sets every register, and x30/x31 stay reserved
+ * as MMIO and RAM pointers. The epilogue stores x1..x29 to RAM and writes
+ * HOST_EXIT, so the final memory image covers the register file.
+ */
+class FuzzProgram {
+public:
+    FuzzProgram(uint32_t seed, uint32_t sequences, uint32_t maxWords) : random(seed) {
+        // Prologue: every register gets a value before the body can read it
+        for (uint32_t reg = 1; reg < 30; reg++) loadImmediate(reg, random());
+        loadImmediate(30, FUZZ_MMIO_POINTER);
+        loadImmediate(31, FUZZ_RAM_POINTER);
+
+        // Room for the epilogue (29 stores, exit store, self loop)
+        const uint32_t reserve = 31;
+        for (uint32_t i = 0; i < sequences && words.size() + 4 + reserve <= maxWords; i++) {
+            boundaries.push_back(words.size());
+            emitSequence();
+        }
+
+        // Epilogue: the last boundary, so every forward jump can land here
+        boundaries.push_back(words.size());
+        for (uint32_t reg = 1; reg < 30; reg++) words.push_back(rv32_enc_s(FUZZ_DUMP_OFFSET + 4 * reg, reg, 31, 2));
+        words.push_back(rv32_enc_s(FUZZ_EXIT_OFFSET, 0, 30, 2));
+        words.push_back(rv32_enc_j(0, 0));
+
+        for (const Fixup &fixup : fixups) resolve(fixup);
+    }
+
+    // Sets MIE = 0 (a timer trap taken first lands on the park loop at
+    // 0x10 with MIE already cleared by the entry), then polls the mailbox
+    static std::vector<uint32_t> bootStub() {
+        return {
+            rv32_enc_u(FUZZ_MMIO_POINTER >> 12, 1, OP_LUI),   // 0x00 lui  ra, 0x40000
+            rv32_enc_s(0x20, 0, 1, 2),                         // 0x04 sw   zero, 0x20(ra): MSTATUS
+            rv32_enc_j(0x10 - 0x08, 0),                        // 0x08 j    0x10
+            0x00000013,                                        // 0x0C nop
+            rv32_enc_u(FUZZ_MAILBOX >> 12, 3, OP_LUI),         // 0x10 lui  gp, 0x20000
+            rv32_enc_i(FUZZ_MAILBOX & 0xFFF, 3, 2, 2, OP_LOAD),// 0x14 lw   sp, 0(gp)
+            rv32_enc_b(-4, 0, 2, 0),                           // 0x18 beqz sp, 0x14
+            rv32_enc_i(0, 2, 0, 0, OP_JALR),                   // 0x1C jr   sp
+        };
+    }
+
+    std::vector<uint32_t> words;   // Loaded at FUZZ_PROGRAM_BASE
+
+private:
+    enum FixupKind { BRANCH, JUMP, JUMP_REGISTER };
+    struct Fixup { FixupKind kind; size_t word; uint32_t rd, rs1, rs2, funct3; size_t target; };
+
+    uint32_t pick(uint32_t bound) { return random() % bound; }
+    uint32_t anyRegister() { return pick(32); }
+    uint32_t destination() { return 1 + pick(29); }   // Never x0, x30 or x31
+
+    void loadImmediate(uint32_t rd, uint32_t value) {
+        uint32_t upper = (value + 0x800) >> 12;
+        words.push_back(rv32_enc_u(upper & 0xFFFFF, rd, OP_LUI));
+        words.push_back(rv32_enc_i((int32_t)(value - (upper << 12)), rd, 0, rd, OP_I_TYPE));
+    }
+
+    // Aligned word offset from x31 anywhere in the 4 KiB RAM
+    int32_t ramOffset() { return -2048 + 4 * (int32_t)pick(1024); }
+
+    // Offset within the word for a naturally aligned access of this funct3's width
+    int32_t laneOffset(uint32_t funct3) {
+        uint32_t size = 1u << (funct3 & 3);
+        return size == 4 ? 0 : (int32_t)(size * pick(4 / size));
+    }
+
+    // A later sequence boundary (or the epilogue) within a short distance
+    size_t forwardTarget() { return boundaries.size() + pick(12); }
+
+    void emitSequence() {
+        static const uint32_t IMMEDIATE_FUNCT3[] = {0, 2, 3, 4, 6, 7};             // ADDI SLTI SLTIU XORI ORI ANDI
+        static const uint32_t REGISTER_OPS[][2]  = {                               // {funct7, funct3}
+            {0x00, 0}, {0x20, 0}, {0x00, 4}, {0x00, 6}, {0x00, 7},                 // ADD SUB XOR OR AND
+            {0x00, 1}, {0x00, 5}, {0x20, 5}, {0x00, 2}, {0x00, 3},                 // SLL SRL SRA SLT SLTU
+            {0x20, 7}, {0x20, 6}, {0x20, 4}, {0x05, 4}, {0x05, 5}, {0x05, 6}, {0x05, 7}, // ANDN..MAXU
+            {0x10, 2}, {0x10, 4}, {0x10, 6}, {0x30, 1}, {0x30, 5},                 // SHnADD ROL ROR
+        };
+        static const uint32_t UNARY_OPS[] = {                                      // Zbb, rs1 only (imm[11:0])
+            0x600, 0x601, 0x602, 0x604, 0x605, 0x287, 0x698,                       // CLZ CTZ CPOP SEXT.B/H ORC.B REV8
+        };
+        static const uint32_t SHIFT_FUNCT[][2] = {{0x00, 1}, {0x00, 5}, {0x20, 5}}; // SLLI SRLI SRAI
+        static const uint32_t LOAD_FUNCT3[]    = {2, 0, 1, 4, 5};                  // LW LB LH LBU LHU
+        static const uint32_t BRANCH_FUNCT3[]  = {0, 1, 4, 5, 6, 7};               // BEQ BNE BLT BGE BLTU BGEU
+        static const uint32_t AMO_FUNCT5[] = {0x00, 0x01, 0x04, 0x08, 0x0C, 0x10, 0x14, 0x18, 0x1C};
+
+        uint32_t rd = destination();
+        switch (pick(16)) {
+            case 0: case 1: case 2: {                                               // OP-IMM
+                if (pick(3) == 0) {
+                    const uint32_t *shift = SHIFT_FUNCT[pick(3)];
+                    words.push_back(rv32_enc_i((shift[0] << 5) | pick(32), anyRegister(), shift[1], rd, OP_I_TYPE));
+                } else {
+                    uint32_t funct3 = IMMEDIATE_FUNCT3[pick(6)];
+                    words.push_back(rv32_enc_i((int32_t)pick(4096) - 2048, anyRegister(), funct3, rd, OP_I_TYPE));
+                }
+                break;
+            }
+            case 3: case 4: case 5: {                                               // OP
+                const uint32_t *op = REGISTER_OPS[pick(sizeof(REGISTER_OPS) / sizeof(REGISTER_OPS[0]))];
+                words.push_back(rv32_enc_r(op[0], anyRegister(), anyRegister(), op[1], rd, OP_R_TYPE));
+                break;
+            }
+            case 6: {                                                               // Zbb unary / RORI / ZEXT.H
+                uint32_t choice = pick(9);
+                if (choice < 7) {
+                    uint32_t imm = UNARY_OPS[choice];
+                    words.push_back(rv32_enc_i(imm, anyRegister(), (imm == 0x287 || imm == 0x698) ? 5 : 1, rd, OP_I_TYPE));
+                } else if (choice == 7) {
+                    words.push_back(rv32_enc_i(0x600 | pick(32), anyRegister(), 5, rd, OP_I_TYPE));   // RORI
+                } else {
+                    words.push_back(rv32_enc_r(0x04, 0, anyRegister(), 4, rd, OP_R_TYPE));           // ZEXT.H
+                }
+                break;
+            }
+            case 7:                                                                 // LUI / AUIPC
+                words.push_back(rv32_enc_u(random() & 0xFFFFF, rd, pick(2) ? OP_LUI : OP_AUIPC));
+                break;
+            case 8: {                                                               // RAM load
+                uint32_t funct3 = LOAD_FUNCT3[pick(5)];
+                words.push_back(rv32_enc_i(ramOffset() + laneOffset(funct3), 31, funct3, rd, OP_LOAD));
+                break;
+            }
+            case 9: case 10: {                                                      // RAM store (SB SH SW)
+                uint32_t funct3 = pick(3);
+                words.push_back(rv32_enc_s(ramOffset() + laneOffset(funct3), anyRegister(), 31, funct3));
+                break;
+            }
+            case 11: {                                                              // ROM load (constants, this program)
+                uint32_t funct3 = LOAD_FUNCT3[pick(5)];
+                words.push_back(rv32_enc_i(4 * (int32_t)pick(512) + laneOffset(funct3), 0, funct3, rd, OP_LOAD));
+                break;
+            }
+            case 12: {                                                              // MMIO
+                switch (pick(5)) {
+                    case 0: words.push_back(rv32_enc_s(0x00, anyRegister(), 30, 2)); break;    // UART data
+                    case 1: words.push_back(rv32_enc_s(0x08, anyRegister(), 30, 2)); break;    // UART divisor
+                    case 2: words.push_back(rv32_enc_i(0x08, 30, 2, rd, OP_LOAD)); break;
+                    case 3: words.push_back(rv32_enc_i(0x14, 30, 2, rd, OP_LOAD)); break;      // MHARTID
+                    case 4: words.push_back(rv32_enc_i(0x1C, 30, 2, rd, OP_LOAD)); break;      // Hart count
+                }
+                break;
+            }
+            case 13: {                                                              // RV32A on a RAM word
+                uint32_t address = destination();
+                while (rd == address) rd = destination();
+                words.push_back(rv32_enc_i(ramOffset(), 31, 0, address, OP_I_TYPE));
+                uint32_t kind = pick(4);
+                if (kind == 0) {
+                    words.push_back(rv32_enc_r(0x02 << 2, 0, address, 2, rd, OP_AMO));                  // LR.W
+                    if (pick(2)) words.push_back(rv32_enc_r(0x03 << 2, anyRegister(), address, 2, destination(), OP_AMO));
+                } else if (kind == 1) {
+                    words.push_back(rv32_enc_r(0x03 << 2, anyRegister(), address, 2, rd, OP_AMO));      // SC.W
+                } else {
+                    words.push_back(rv32_enc_r(AMO_FUNCT5[pick(9)] << 2, anyRegister(), address, 2, rd, OP_AMO));
+                }
+                break;
+            }
+            case 14: {                                                              // Branch, equal operands half the time
+                uint32_t rs1 = anyRegister();
+                uint32_t rs2 = pick(2) ? rs1 : (pick(2) ? 0 : anyRegister());
+                fixups.push_back({BRANCH, words.size(), 0, rs1, rs2, BRANCH_FUNCT3[pick(6)], forwardTarget()});
+                words.push_back(0);
+                break;
+            }
+            case 15: {                                                              // JAL / JALR (via lui+addi)
+                if (pick(2)) {
+                    fixups.push_back({JUMP, words.size(), rd, 0, 0, 0, forwardTarget()});
+                    words.push_back(0);
+                } else {
+                    uint32_t base = destination();
+                    fixups.push_back({JUMP_REGISTER, words.size(), rd, base, 0, 0, forwardTarget()});
+                    words.insert(words.end(), 3, 0);
+                }
+                break;
+            }
+        }
+    }
+
+    void resolve(const Fixup &fixup) {
+        size_t   target  = fixup.target < boundaries.size() ? boundaries[fixup.target] : boundaries.back();
+        int32_t  offset  = 4 * ((int32_t)target - (int32_t)fixup.word);
+        uint32_t address = FUZZ_PROGRAM_BASE + 4 * target;
+        switch (fixup.kind) {
+            case BRANCH:
+                words[fixup.word] = rv32_enc_b(offset, fixup.rs2, fixup.rs1, fixup.funct3);
+                break;
+            case JUMP:
+                words[fixup.word] = rv32_enc_j(offset, fixup.rd);
+                break;
+            case JUMP_REGISTER: {
+                int32_t  low   = (int32_t)pick(16) * 4 - 32;                        // Exercise the JALR offset too
+                uint32_t base  = address - low;
+                uint32_t upper = (base + 0x800) >> 12;
+                words[fixup.word]     = rv32_enc_u(upper, fixup.rs1, OP_LUI);
+                words[fixup.word + 1] = rv32_enc_i((int32_t)(base - (upper << 12)), fixup.rs1, 0, fixup.rs1, OP_I_TYPE);
+                words[fixup.word + 2] = rv32_enc_i(low, fixup.rs1, 0, fixup.rd, OP_JALR);
+                break;
+            }
+        }
+    }
+
+    std::mt19937        random;
+    std::vector<size_t> boundaries;   // Word index of each sequence start; the last is the epilogue
+    std::vector<Fixup>  fixups;
+};
+
+#endif
@@ -0,0 +1,71 @@
+#include <iostream>
+#include "tb_framework.h"
+#include "Vhart_arbiter.h"
+
+// Default parameters: 2 harts, 1-bit hart index
+
+// Presents 'request' and returns the combinational grant
+int grant_for(Vhart_arbiter* top, int request) {
+    top->request = request;
+    top->eval();
+    return top->grant;
+}
+
+int main(int argc, char** argv) {
+    Testbench<Vhart_arbiter> tb(argc, argv, "Hart Arbiter");
+    Vhart_arbiter* arb = tb.dut();
+
+    // ==========================================
+    // TEST 1: RESET & FIRST TIE
+    // ==========================================
+    arb->request = 0;
+    tb.reset();
+
+    if (!tb.check(grant_for(arb, 0b00) == 0 && grant_for(arb, 0b11) == 0b01 && arb->grantedHart == 0,
+                  "Idle bus grants nobody; hart 0 wins the first tie.")) {
+        std::cout << "  Reset priority wrong. Grant: " << (int)arb->grant << "\n";
+    }
+
+    // ==========================================
+    // TEST 2: ROUND-ROBIN UNDER FULL CONTENTION
+    // ==========================================
+    // Both harts request every cycle: grants must alternate 0,1,0,1...
+    // (grant is sampled before the edge)
+    int expected = 0b01;
+    tb.vectors("Round-Robin: contending harts alternate every cycle.", 8, [&](uint64_t cycle) {
+        int grant = grant_for(arb, 0b11);
+        if (grant != expected) {
+            std::cout << "  Cycle " << cycle << ": expected grant " << expected << ", got " << grant << "\n";
+            return false;
+        }
+        tb.tick();
+        expected ^= 0b11;
+        return true;
+    });
+
+    // ==========================================
+    // TEST 3: SOLE REQUESTER IS NEVER HELD OFF
+    // ==========================================
+    // Hart 1 alone keeps the bus cycle after cycle
+    bool soleOk = true;
+    for (int cycle = 0; cycle < 4; cycle++) {
+        soleOk &= grant_for(arb, 0b10) == 0b10 && arb->grantedHart == 1;
+        tb.tick();
+    }
+    // After hart 1's run, hart 0 is next in line on a tie
+    soleOk &= grant_for(arb, 0b11) == 0b01;
+
+    tb.check(soleOk, "Sole requester granted back-to-back; priority rotates after it.",
+             "Sole requester was stalled or priority did not rotate.");
+
+    // ==========================================
+    // TEST 4: IDLE CYCLES KEEP THE POINTER
+    // ==========================================
+    tb.tick();              // Hart 0 granted above
+    grant_for(arb, 0b00);
+    tb.tick();              // Nobody requests: pointer must not move
+    tb.check(grant_for(arb, 0b11) == 0b10, "Idle cycles do not disturb the round-robin order.",
+             "Idle cycle changed the round-robin order.");
+
+    return tb.finish();
+}
@@ -0,0 +1,63 @@
+#ifndef HOST_CHANNEL_H
+#define HOST_CHANNEL_H
+
+#include <cstdint>
+#include <iostream>
+#include "memory_backdoor.h"
+
+// --- HOST REGION (0x40000100 - 0x400001FF) ---
+// Serviced by the testbench, not by RTL (except the cycle counter reads).
+#define HOST_REGION_BASE  0x40000100
+#define HOST_REGION_MASK  0xFFFFFF00
+#define HOST_PUTS         0x40000100 // W: pointer to NUL-terminated string
+#define HOST_EXIT         0x40000104 // W: end simulation with this status
+#define HOST_CYCLE_LO     0x40000108 // R: cycle counter [31:0]  (RTL)
+#define HOST_CYCLE_HI     0x4000010C // R: cycle counter [63:32] (RTL)
+#define HOST_PUTC         0x40000110 // W: single character, no UART timing
+
+#define HOST_ASSERT_FAILED 0xA5A50000 // Exit status of host_assert(): | line
+
+/**
+ * @brief Semihosting-style console and exit channel.
+ * Firmware stores to the host region; the harness prints the string or
+ * terminates the run immediately instead of waiting for MAX_SIM_TICKS.
+ */
+class HostChannel {
+public:
+    explicit HostChannel(Vsoc_top *dut) : dut(dut) {}
+
+    // Returns true if the write targeted the host region
+    bool onMmioWrite(uint32_t address, uint32_t data) {
+        if ((address & HOST_REGION_MASK) != HOST_REGION_BASE) return false;
+
+        switch (address) {
+            case HOST_PUTS:
+                std::cout << backdoor_read_string(dut, data) << std::flush;
+                break;
+            case HOST_PUTC:
+                std::cout << (char)data << std::flush;
+                break;
+            case HOST_EXIT:
+                exitRequested = true;
+                exitCode      = (int)data;
+                break;
+            default:
+                std::cout << "\n[HOST] Ignored write to 0x" << std::hex << address << std::dec << std::endl;
+                break;
+        }
+        return true;
+    }
+
+    bool assertionFailed() const {
+        return exitRequested && ((uint32_t)exitCode & 0xFFFF0000) == HOST_ASSERT_FAILED;
+    }
+    uint32_t assertionLine() const { return (uint32_t)exitCode & 0xFFFF; }
+
+    bool exitRequested = false;
+    int  exitCode      = 0;
+
+private:
+    Vsoc_top *dut;
+};
+
+#endif
@@ -0,0 +1,125 @@
+#include <iostream>
+#include "tb_framework.h"
+#include "Vicache.h"
+
+// Default parameters: 2 ways, 16 sets, 4-word (16 byte) lines
+const int LINE_BYTES    = 16;
+const int SETS          = 16;
+const int FLASH_LATENCY = 6;
+
+// Every flash word holds a value derived from its address
+uint32_t flash_word(uint32_t address) { return (address & ~3u) * 2654435761u; }
+
+// --- HELPER: BEHAVIOURAL FLASH ---
+// Accepts one line read at a time and answers after FLASH_LATENCY cycles.
+struct FlashStub {
+    bool     busy      = false;
+    int      countdown = 0;
+    uint32_t lineBase  = 0;
+};
+
+typedef Testbench<Vicache> CacheBench;
+
+// Drives the refill port, then steps the clock one rising edge
+void step(CacheBench& tb, FlashStub& flash) {
+    Vicache* top = tb.dut();
+    top->lineRequestReady  = !flash.busy;
+    top->lineResponseValid = flash.busy && flash.countdown == 0;
+    for (int i = 0; i < 4; i++) top->lineResponseData[i] = flash_word(flash.lineBase + 4 * i);
+    top->eval();
+
+    bool     accepted = !flash.busy && top->lineRequestValid;
+    uint32_t address  = top->lineRequestAddress;
+
+    tb.tick();
+
+    if (top->lineResponseValid)  flash.busy = false;
+    else if (flash.busy)         flash.countdown--;
+    if (accepted) {
+        flash.busy      = true;
+        flash.countdown = FLASH_LATENCY;
+        flash.lineBase  = address & ~(uint32_t)(LINE_BYTES - 1);
+    }
+    top->lineResponseValid = 0;
+    top->eval();
+}
+
+// Presents 'address' and runs until the cache delivers it; returns stall cycles
+int fetch(CacheBench& tb, FlashStub& flash, uint32_t address) {
+    Vicache* top = tb.dut();
+    top->fetchAddress = address;
+    top->eval();
+    int stalls = 0;
+    while (!top->fetchReady) {
+        step(tb, flash);
+        if (++stalls > 100) return -1;
+    }
+    return stalls;
+}
+
+int main(int argc, char** argv) {
+    CacheBench tb(argc, argv, "Instruction Cache");
+    Vicache* cache = tb.dut();
+    FlashStub flash;
+
+    // ==========================================
+    // TEST 1: COLD MISS
+    // ==========================================
+    cache->resetActiveLow = 0;
+    cache->fetchEnable    = 1;
+    step(tb, flash);
+    cache->resetActiveLow = 1;
+
+    cache->fetchAddress = 0x100;
+    cache->eval();
+    tb.check(cache->fetchReady == 0 && cache->lineRequestValid == 1,
+             "Cold Miss: Fetch stalled and refill requested.",
+             "Cold Miss: Cache reported a hit after reset.");
+
+    int stalls = fetch(tb, flash, 0x100);
+    tb.check(stalls > FLASH_LATENCY && cache->fetchData == flash_word(0x100),
+             "Refill: Line installed after " + std::to_string(stalls) + " stall cycles.",
+             "Stalls " + std::to_string(stalls) + ", data " + tb_hex(cache->fetchData));
+
+    // ==========================================
+    // TEST 2: SPATIAL HIT (SAME LINE)
+    // ==========================================
+    bool lineOk = true;
+    for (uint32_t offset = 0; offset < LINE_BYTES; offset += 4) {
+        if (fetch(tb, flash, 0x100 + offset) != 0 || cache->fetchData != flash_word(0x100 + offset)) lineOk = false;
+        step(tb, flash);
+    }
+    tb.check(lineOk, "Spatial Hit: All words of the line served with no stall.",
+             "Spatial Hit: Word in a resident line missed or mismatched.");
+
+    // ==========================================
+    // TEST 3: TWO-WAY ASSOCIATIVITY & LRU
+    // ==========================================
+    // A, B and C all map to set 0 with different tags.
+    const uint32_t A = 0x100, B = A + LINE_BYTES * SETS, C = B + LINE_BYTES * SETS;
+
+    fetch(tb, flash, B); step(tb, flash);          // Fill B (second way)
+    bool bothResident = fetch(tb, flash, A) == 0;  // A still present
+    step(tb, flash);                               // A used last -> B is LRU
+    fetch(tb, flash, C); step(tb, flash);          // C evicts B
+    bool aKept   = fetch(tb, flash, A) == 0 && cache->fetchData == flash_word(A);
+    step(tb, flash);
+    bool bEvicted = fetch(tb, flash, B) > 0 && cache->fetchData == flash_word(B);
+
+    if (!tb.check(bothResident && aKept && bEvicted,
+                  "Associativity: Conflicting lines coexist, LRU line evicted.")) {
+        std::cout << "  Associativity: resident=" << bothResident << " kept=" << aKept
+                  << " evicted=" << bEvicted << "\n";
+    }
+
+    // ==========================================
+    // TEST 4: STATISTICS
+    // ==========================================
+    // Misses: A (cold), B, C, B again
+    tb.check(cache->missCount == 4 && cache->hitCount > 0 && cache->stallCycles > 4 * FLASH_LATENCY,
+             "Counters: " + std::to_string(cache->hitCount) + " hits, " + std::to_string(cache->missCount) +
+             " misses, " + std::to_string(cache->stallCycles) + " stall cycles.",
+             "misses=" + std::to_string(cache->missCount) + " hits=" + std::to_string(cache->hitCount));
+
+    return tb.finish();
+}
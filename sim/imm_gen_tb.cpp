@@ -1,19 +1,14 @@
 #include <iostream>
-#include <verilated.h>
+#include "tb_framework.h"
+#include "rv32_decode_ref.h"
 #include "Vimm_gen.h"
 
-// --- OPCODE DEFINITIONS ---
-#define OP_I_TYPE  0x13 // 0010011 (ADDI)
-#define OP_S_TYPE  0x23 // 0100011 (SW)
-#define OP_B_TYPE  0x63 // 1100011 (BEQ)
-#define OP_U_TYPE  0x37 // 0110111 (LUI)
-#define OP_J_TYPE  0x6F // 1101111 (JAL)
+// Randomised upper bits per opcode in the default sweep; +exhaustive runs all 2^32 words
+#define SWEEP_PER_OPCODE (1u << 17)
 
 int main(int argc, char** argv) {
-    Verilated::commandArgs(argc, argv);
-    Vimm_gen* dut = new Vimm_gen;
-
-    std::cout << "[TEST] Starting Immediate Generator Verification...\n";
+    Testbench<Vimm_gen> tb(argc, argv, "Immediate Generator");
+    Vimm_gen* dut = tb.dut();
 
     // ==========================================
     // TEST 1: I-TYPE (Negative Number Check)
@@ -28,12 +23,8 @@ int main(int argc, char** argv) {
     dut->eval();
 
     // Expect 32-bit sign extended -1 (0xFFFFFFFF)
-    if (dut->immediateValue == 0xFFFFFFFF) {
-        std::cout << "[PASS] I-Type (Negative): Sign Extension correct (-1).\n";
-    } else {
-        std::cout << "[FAIL] I-Type Failed. Expected -1, Got: " << (int)dut->immediateValue << "\n";
-        return 1;
-    }
+    tb.check(dut->immediateValue == 0xFFFFFFFF, "I-Type (Negative): Sign Extension correct (-1).",
+             "I-Type Failed. Expected -1, Got: " + std::to_string((int)dut->immediateValue));
 
     // ==========================================
     // TEST 2: S-TYPE (Split Field Check)
@@ -48,12 +39,8 @@ int main(int argc, char** argv) {
     dut->instruction = 0xFE002FA3;
     dut->eval();
 
-    if (dut->immediateValue == 0xFFFFFFFF) {
-        std::cout << "[PASS] S-Type (Store): Split Immediate Reassembly correct (-1).\n";
-    } else {
-        std::cout << "[FAIL] S-Type Failed. Expected -1, Got: " << (int)dut->immediateValue << "\n";
-        return 1;
-    }
+    tb.check(dut->immediateValue == 0xFFFFFFFF, "S-Type (Store): Split Immediate Reassembly correct (-1).",
+             "S-Type Failed. Expected -1, Got: " + std::to_string((int)dut->immediateValue));
 
     // ==========================================
     // TEST 3: B-TYPE (The "Scrambler" Check)
@@ -72,12 +59,8 @@ int main(int argc, char** argv) {
     dut->eval();
 
     // Expected: -4 (0xFFFFFFFC)
-    if (dut->immediateValue == 0xFFFFFFFC) {
-        std::cout << "[PASS] B-Type (Branch): Scrambler Logic correct (-4).\n";
-    } else {
-        std::cout << "[FAIL] B-Type Failed. Expected -4 (0xFFFFFFFC), Got: " << std::hex << dut->immediateValue << "\n";
-        return 1;
-    }
+    tb.check(dut->immediateValue == 0xFFFFFFFC, "B-Type (Branch): Scrambler Logic correct (-4).",
+             "B-Type Failed. Expected -4 (0xFFFFFFFC), Got: " + tb_hex(dut->immediateValue));
 
     // ==========================================
     // TEST 4: U-TYPE (Upper Immediate)
@@ -89,12 +72,8 @@ int main(int argc, char** argv) {
     dut->eval();
 
     // Expected: 0x12345000 (Lower 12 bits zeroed)
-    if (dut->immediateValue == 0x12345000) {
-        std::cout << "[PASS] U-Type (LUI): Shift Logic correct.\n";
-    } else {
-        std::cout << "[FAIL] U-Type Failed. Expected 0x12345000, Got: " << std::hex << dut->immediateValue << "\n";
-        return 1;
-    }
+    tb.check(dut->immediateValue == 0x12345000, "U-Type (LUI): Shift Logic correct.",
+             "U-Type Failed. Expected 0x12345000, Got: " + tb_hex(dut->immediateValue));
 
     // ==========================================
     // TEST 5: J-TYPE (Function Call Check)
@@ -106,16 +85,25 @@ int main(int argc, char** argv) {
     dut->eval();
 
     // Expected: -4 (0xFFFFFFFC)
-    if (dut->immediateValue == 0xFFFFFFFC) {
-        std::cout << "[PASS] J-Type (Jump): Scrambler Logic correct (-4).\n";
-    } else {
-        std::cout << "[FAIL] J-Type Failed. Expected -4, Got: " << std::hex << dut->immediateValue << "\n";
-        return 1;
-    }
+    tb.check(dut->immediateValue == 0xFFFFFFFC, "J-Type (Jump): Scrambler Logic correct (-4).",
+             "J-Type Failed. Expected -4, Got: " + tb_hex(dut->immediateValue));
 
-    std::cout << "------------------------------------------\n";
-    std::cout << "[SUCCESS] Immediate Generator Verified.\n";
+    // ==========================================
+    // TEST 6: DECODE SWEEP vs REFERENCE
+    // ==========================================
+    // All 128 opcodes, each with randomised bits [31:7]
+    bool exhaustive = Verilated::commandArgsPlusMatch("exhaustive")[0] != 0;
+    uint64_t count  = exhaustive ? (1ull << 32) : 128ull * SWEEP_PER_OPCODE;
+    tb.parallelVectors(exhaustive ? "All 2^32 Words Match Reference" : "Opcode Sweep Matches Reference", count,
+                       [&tb, exhaustive](Vimm_gen& model, uint64_t index, std::string& detail) {
+        uint32_t insn = exhaustive ? (uint32_t)index : (tb.randomAt(index >> 7) & ~0x7Fu) | (index & 0x7F);
+        model.instruction = insn;
+        model.eval();
+        uint32_t expected = rv32_ref_immediate(insn);
+        if (model.immediateValue == expected) return true;
+        detail = tb_hex(insn) + ": got " + tb_hex(model.immediateValue) + ", expected " + tb_hex(expected);
+        return false;
+    });
 
-    delete dut;
-    return 0;
+    return tb.finish();
 }
\ No newline at end of file
@@ -1,8 +1,8 @@
 #include <iostream>
 #include <fstream>
-#include <verilated.h>
 #include <sys/stat.h> // For creating directories
 #include "Vinst_mem.h"
+#include "tb_framework.h"
 
 // --- HELPER: CREATE DUMMY FIRMWARE ---
 // We create a file with known data so we can verify the ROM loaded it.
@@ -25,14 +25,13 @@ void create_dummy_firmware() {
 }
 
 int main(int argc, char** argv) {
-    Verilated::commandArgs(argc, argv);
-
     // CRITICAL: Create the file BEFORE starting the module
     create_dummy_firmware();
 
-    Vinst_mem* rom = new Vinst_mem;
-
-    std::cout << "[TEST] Starting Instruction Memory Verification...\n";
+    // tb.tick() clocks the presented addresses in. With syncRead=0 the tick
+    // changes nothing, so the same checks cover both ROM variants.
+    Testbench<Vinst_mem> tb(argc, argv, "Instruction Memory");
+    Vinst_mem* rom = tb.dut();
 
     // ==========================================
     // TEST 1: INSTRUCTION FETCH (PORT A)
@@ -40,13 +39,11 @@ int main(int argc, char** argv) {
     // We expect Address 0 to hold DEADBEEF (from our dummy file)
     
     rom->romAxiReadAddress = 0x00000000;
-    rom->eval(); // Combinational Read (No Clock needed for ROM usually)
+    tb.tick(); // Combinational read ignores the clock; registered read samples here
 
-    if (rom->romAxiReadData == 0xDEADBEEF) {
-        std::cout << "[PASS] Port A (Instruction Fetch): Loaded 0xDEADBEEF correctly.\n";
-    } else {
-        std::cout << "[FAIL] Port A Failed. Expected DEADBEEF, Got: " << std::hex << rom->romAxiReadData << "\n";
-        return 1;
+    if (!tb.check(rom->romAxiReadData == 0xDEADBEEF,
+                  "Port A (Instruction Fetch): Loaded 0xDEADBEEF correctly.")) {
+        std::cout << "  Port A Failed. Expected DEADBEEF, Got: " << std::hex << rom->romAxiReadData << "\n";
     }
 
     // ==========================================
@@ -55,13 +52,10 @@ int main(int argc, char** argv) {
     // Address 0x04 should point to Index 1 (CAFEBABE)
     
     rom->romAxiReadAddress = 0x00000004;
-    rom->eval();
+    tb.tick();
 
-    if (rom->romAxiReadData == 0xCAFEBABE) {
-        std::cout << "[PASS] Address Alignment: Address 0x4 maps to Index 1.\n";
-    } else {
-        std::cout << "[FAIL] Address Alignment Failed. Expected CAFEBABE, Got: " << std::hex << rom->romAxiReadData << "\n";
-        return 1;
+    if (!tb.check(rom->romAxiReadData == 0xCAFEBABE, "Address Alignment: Address 0x4 maps to Index 1.")) {
+        std::cout << "  Address Alignment Failed. Expected CAFEBABE, Got: " << std::hex << rom->romAxiReadData << "\n";
     }
 
     // ==========================================
@@ -72,23 +66,48 @@ int main(int argc, char** argv) {
     
     rom->romAxiReadAddress = 0x00000000;
     rom->busReadAddress    = 0x00000008; // Address 8 -> Index 2
-    rom->eval();
+    tb.tick();
 
     bool portA_ok = (rom->romAxiReadData == 0xDEADBEEF);
     bool portB_ok = (rom->busReadData    == 0x12345678);
 
-    if (portA_ok && portB_ok) {
-        std::cout << "[PASS] Dual Port Read: CPU and Bus read different addresses simultaneously.\n";
-    } else {
-        std::cout << "[FAIL] Dual Port Read Failed.\n";
+    if (!tb.check(portA_ok && portB_ok,
+                  "Dual Port Read: CPU and Bus read different addresses simultaneously.")) {
+        std::cout << "  Dual Port Read Failed.\n";
         std::cout << "  Port A (Exp DEADBEEF): " << std::hex << rom->romAxiReadData << "\n";
         std::cout << "  Port B (Exp 12345678): " << std::hex << rom->busReadData << "\n";
-        return 1;
     }
 
-    std::cout << "------------------------------------------\n";
-    std::cout << "[SUCCESS] Instruction Memory Verified.\n";
+    // ==========================================
+    // TEST 4: HALFWORD-ALIGNED FETCH (RVC)
+    // ==========================================
+    // Address 0x02 straddles Index 0 and Index 1: low half = DEADBEEF[31:16],
+    // high half = CAFEBABE[15:0]
+
+    rom->romAxiReadAddress = 0x00000002;
+    tb.tick();
+
+    if (!tb.check(rom->romAxiReadData == 0xBABEDEAD,
+                  "Misaligned Fetch: Address 0x2 spans Index 0 and Index 1.")) {
+        std::cout << "  Misaligned Fetch Failed. Expected BABEDEAD, Got: " << std::hex << rom->romAxiReadData << "\n";
+    }
+
+    // ==========================================
+    // TEST 5: ODD-WORD FETCH (BANK ORDER)
+    // ==========================================
+    // Words alternate between the even and odd banks. From an odd word the
+    // successor comes from the even bank: 0x06 spans Index 1 and Index 2.
+    // The bus port reads the odd bank at the same time.
+
+    rom->romAxiReadAddress = 0x00000006;
+    rom->busReadAddress    = 0x00000004;
+    tb.tick();
+
+    if (!tb.check(rom->romAxiReadData == 0x5678CAFE && rom->busReadData == 0xCAFEBABE,
+                  "Odd-Word Fetch: Address 0x6 spans Index 1 and Index 2 across the banks.")) {
+        std::cout << "  Odd-Word Fetch Failed. Expected 5678CAFE / CAFEBABE, Got: " << std::hex
+                  << rom->romAxiReadData << " / " << rom->busReadData << "\n";
+    }
 
-    delete rom;
-    return 0;
+    return tb.finish();
 }
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include <iostream>
+#include "Virq_controller.h"
+#include "tb_framework.h"
+
+// Default parameters: 4 sources, nothing enabled out of reset.
+// sourceLevel is declared [sources:1], so source ID N is bit N-1 here.
+
+#define REG_PENDING   0x00
+#define REG_ENABLE    0x04
+#define REG_THRESHOLD 0x08
+#define REG_CLAIM     0x0C
+#define REG_MTVEC     0x10
+#define REG_ACTIVE    0x14
+#define REG_PRIORITY(id) (0x20 + 4 * (id))
+
+typedef Testbench<Virq_controller> IrqBench;
+
+void write_reg(IrqBench& tb, int offset, uint32_t data) {
+    tb->registerOffset = offset; tb->registerWriteData = data; tb->registerWriteValid = 1;
+    tb.tick();
+    tb->registerWriteValid = 0;
+}
+
+uint32_t read_reg(IrqBench& tb, int offset) {
+    tb->registerOffset = offset;
+    tb->eval();
+    return tb->registerReadData;
+}
+
+// Raise the source's level for one edge (one rising edge into the gateway)
+void pulse(IrqBench& tb, int id) {
+    tb->sourceLevel |= (1 << (id - 1));
+    tb.tick();
+    tb->sourceLevel &= ~(1 << (id - 1));
+    tb.tick();
+}
+
+// The core takes the trap: the best source is claimed on this edge
+void take_trap(IrqBench& tb) {
+    tb->trapTaken = 1;
+    tb.tick();
+    tb->trapTaken = 0;
+    tb->eval();
+}
+
+int main(int argc, char** argv) {
+    IrqBench tb(argc, argv, "Interrupt Controller");
+    Virq_controller* irq = tb.dut();
+
+    // ==========================================
+    // TEST 1: RESET STATE
+    // ==========================================
+    tb.reset();
+    tb.tick();
+
+    tb.check(!irq->interruptRequest && irq->interruptVector == 0x10 && read_reg(tb, REG_MTVEC) == 0x10 &&
+             read_reg(tb, REG_ENABLE) == 0 && read_reg(tb, REG_PRIORITY(1)) == 0,
+             "Reset: direct mode at 0x10, all sources off.", "Reset state wrong.");
+
+    // ==========================================
+    // TEST 2: EDGE GATEWAY & CLAIM
+    // ==========================================
+    // A source held high interrupts once: claiming clears pending and the
+    // level does not set it again until the next rising edge.
+    write_reg(tb, REG_PRIORITY(1), 1);
+    write_reg(tb, REG_ENABLE, 1 << 1);
+    irq->sourceLevel = 0b0001;
+    tb.tick();
+
+    bool raised = irq->interruptRequest && read_reg(tb, REG_PENDING) == (1 << 1);
+    take_trap(tb);
+    tb.tick();
+    bool claimed = !irq->interruptRequest && read_reg(tb, REG_PENDING) == 0 && read_reg(tb, REG_CLAIM) == 1 &&
+                   read_reg(tb, REG_ACTIVE) == (1 << 1);
+    irq->sourceLevel = 0;
+    write_reg(tb, REG_CLAIM, 1);
+    bool completed = read_reg(tb, REG_ACTIVE) == 0;
+
+    if (!tb.check(raised && claimed && completed, "Edge-triggered pending, claim on trap entry, complete.")) {
+        std::cout << "  Edge/claim/complete wrong (raised " << raised << ", claimed " << claimed
+                  << ", completed " << completed << ").\n";
+    }
+
+    // ==========================================
+    // TEST 3: PRIORITY ORDER & TIES
+    // ==========================================
+    write_reg(tb, REG_PRIORITY(2), 2);
+    write_reg(tb, REG_PRIORITY(3), 2);
+    write_reg(tb, REG_PRIORITY(4), 5);
+    write_reg(tb, REG_ENABLE, 0b11110);
+    pulse(tb, 3);
+    pulse(tb, 2);
+    pulse(tb, 1);
+    take_trap(tb);
+    bool tieOk = (read_reg(tb, REG_CLAIM) == 2); // Equal priority: lower ID first
+    write_reg(tb, REG_CLAIM, 2);
+    pulse(tb, 4);
+    take_trap(tb);
+    bool highOk = (read_reg(tb, REG_CLAIM) == 4);
+    write_reg(tb, REG_CLAIM, 4);
+    take_trap(tb);
+    bool nextOk = (read_reg(tb, REG_CLAIM) == 3);
+    write_reg(tb, REG_CLAIM, 3);
+    take_trap(tb);
+    bool lastOk = (read_reg(tb, REG_CLAIM) == 1);
+    write_reg(tb, REG_CLAIM, 1);
+
+    if (!tb.check(tieOk && highOk && nextOk && lastOk && read_reg(tb, REG_PENDING) == 0,
+                  "Claims follow priority, lowest ID wins a tie.")) {
+        std::cout << "  Claim order wrong (tie " << tieOk << ", high " << highOk
+                  << ", next " << nextOk << ", last " << lastOk << ").\n";
+    }
+
+    // ==========================================
+    // TEST 4: NESTED PREEMPTION
+    // ==========================================
+    // While source 1 (priority 1) is active, only priorities above 1 interrupt
+    pulse(tb, 1);
+    take_trap(tb);
+    pulse(tb, 1);
+    bool maskedSame = !irq->interruptRequest;
+    pulse(tb, 2);
+    bool preempts = irq->interruptRequest;
+    take_trap(tb);
+    bool nestedClaim = (read_reg(tb, REG_CLAIM) == 2) && (read_reg(tb, REG_ACTIVE) == 0b110);
+    write_reg(tb, REG_CLAIM, 2);
+    bool stillMasked = !irq->interruptRequest; // Source 1 still running
+    write_reg(tb, REG_CLAIM, 1);
+    bool released = irq->interruptRequest;      // The second source-1 edge is now let through
+    take_trap(tb);
+    write_reg(tb, REG_CLAIM, 1);
+
+    if (!tb.check(maskedSame && preempts && nestedClaim && stillMasked && released,
+                  "Higher priority preempts a running handler; equal priority waits.")) {
+        std::cout << "  Nesting wrong (" << maskedSame << preempts << nestedClaim
+                  << stillMasked << released << ").\n";
+    }
+
+    // ==========================================
+    // TEST 5: THRESHOLD & SOFTWARE TRIGGER
+    // ==========================================
+    write_reg(tb, REG_THRESHOLD, 2);
+    write_reg(tb, REG_PENDING, (1 << 1) | (1 << 2)); // Raise sources 1 and 2 from software
+    bool belowMasked = !irq->interruptRequest;
+    write_reg(tb, REG_PENDING, 1 << 4);
+    bool aboveTaken = irq->interruptRequest;
+    take_trap(tb);
+    write_reg(tb, REG_CLAIM, 4);
+    write_reg(tb, REG_THRESHOLD, 0);
+    take_trap(tb);
+    write_reg(tb, REG_CLAIM, 2);
+    take_trap(tb);
+    write_reg(tb, REG_CLAIM, 1);
+
+    tb.check(belowMasked && aboveTaken && read_reg(tb, REG_PENDING) == 0,
+             "Threshold masks low priorities; PENDING writes raise sources.",
+             "Threshold/software trigger wrong.");
+
+    // ==========================================
+    // TEST 6: VECTORED MODE
+    // ==========================================
+    write_reg(tb, REG_MTVEC, 0x00000200 | 1);
+    pulse(tb, 3);
+    uint32_t vector3 = irq->interruptVector;
+    write_reg(tb, REG_MTVEC, 0x00000200);
+    uint32_t direct = irq->interruptVector;
+    take_trap(tb);
+    write_reg(tb, REG_CLAIM, 3);
+
+    if (!tb.check(vector3 == 0x20C && direct == 0x200, "Vectored mode enters at base + 4 * ID.")) {
+        std::cout << "  Vector wrong: vectored 0x" << std::hex << vector3 << ", direct 0x" << direct << "\n";
+    }
+
+    return tb.finish();
+}
@@ -0,0 +1,59 @@
+#ifndef KERNEL_STATS_H
+#define KERNEL_STATS_H
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include "memory_backdoor.h"
+#include "symbol_table.h"
+
+// --- LAYOUT (must match kernel_stats_t in firmware/kernel.h) ---
+#define KERNEL_STATS_MAGIC      0x4B535431
+#define KERNEL_STATS_TASKS      24   // Byte offset of tasks[0]
+#define KERNEL_STATS_TASK_BYTES 20
+
+/**
+ * @brief Dumps the scheduler's accounting (firmware kernel_stats) at the end
+ * of a run, like a one-shot 'top'. The struct is found by symbol and read
+ * through the RAM backdoor, so the firmware spends nothing on reporting.
+ */
+class KernelStats {
+public:
+    KernelStats(Vsoc_top *dut, const SymbolTable &symbols)
+        : dut(dut), address(symbols.address("kernel_stats")) {}
+
+    void printReport() const {
+        if (address == 0xFFFFFFFF || read(0) != KERNEL_STATS_MAGIC) return;
+        uint32_t maxTasks = read(4);
+        uint32_t schedulerCycles = read(12), schedulerCalls = read(16);
+        if (!schedulerCalls) return;
+
+        uint64_t total = schedulerCycles;
+        for (uint32_t id = 0; id < maxTasks; id++) total += task(id, 0);
+
+        std::cout << "[TOP] task  run-cycles   cpu%  dispatches  preempted  voluntary    max-gap" << std::endl;
+        for (uint32_t id = 0; id < maxTasks; id++) {
+            if (!task(id, 4)) continue;
+            std::cout << "[TOP] " << std::setw(4) << id << (id == 0 ? "i" : " ")
+                      << std::setw(11) << task(id, 0)
+                      << std::setw(7) << std::fixed << std::setprecision(1) << 100.0 * task(id, 0) / total
+                      << std::setw(12) << task(id, 4) << std::setw(11) << task(id, 8)
+                      << std::setw(11) << task(id, 12) << std::setw(11) << task(id, 16) << std::endl;
+        }
+        std::cout << "[TOP] scheduler: " << schedulerCycles << " cycles in " << schedulerCalls
+                  << " calls (" << std::fixed << std::setprecision(1) << 100.0 * schedulerCycles / total
+                  << "%, " << schedulerCycles / schedulerCalls << " per call), "
+                  << read(20) << " switches (task 0i = idle)" << std::endl;
+    }
+
+private:
+    uint32_t read(uint32_t offset) const { return backdoor_read_word(dut, address + offset); }
+    uint32_t task(uint32_t id, uint32_t field) const {
+        return read(KERNEL_STATS_TASKS + id * KERNEL_STATS_TASK_BYTES + field);
+    }
+
+    Vsoc_top *dut;
+    uint32_t  address;
+};
+
+#endif
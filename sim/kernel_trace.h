@@ -0,0 +1,157 @@
+#ifndef KERNEL_TRACE_H
+#define KERNEL_TRACE_H
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "memory_backdoor.h"
+#include "soc_config.h"
+
+// --- RING LAYOUT (must match firmware/trace.h) ---
+#define TRACE_BASE      0x20000100
+#define TRACE_CAPACITY  32
+#define TRACE_MAGIC     0x54524331
+
+#define TRACE_IRQ_ENTER   1
+#define TRACE_IRQ_EXIT    2
+#define TRACE_SWITCH      3
+#define TRACE_TASK_CREATE 4
+#define TRACE_YIELD       5
+
+/**
+ * @brief Drains the firmware's kernel event ring through the RAM backdoor.
+ * The firmware only pays for four stores per event; decoding, per-task CPU
+ * accounting and the Chrome trace (chrome://tracing, Perfetto) happen here.
+ */
+class KernelTrace {
+public:
+    struct Event {
+        uint32_t cycle;
+        uint8_t  type;
+        uint8_t  task;
+        uint16_t arg;
+    };
+
+    explicit KernelTrace(Vsoc_top *dut) : dut(dut) {}
+
+    // Call when the firmware stores the second word of an entry (the harness
+    // sees it as a bus write); costs one backdoor read when nothing changed
+    void poll() {
+        uint32_t count = backdoor_read_word(dut, TRACE_BASE);
+        if (count == consumed) return;
+        if (backdoor_read_word(dut, TRACE_BASE + 4) != TRACE_MAGIC) return;
+
+        // trace_init() resets the counter; resynchronise on it
+        if (count < consumed) consumed = 0;
+        if (count - consumed > TRACE_CAPACITY) {
+            dropped  += count - consumed - TRACE_CAPACITY;
+            consumed  = count - TRACE_CAPACITY;
+        }
+        for (; consumed < count; consumed++) {
+            uint32_t entry = TRACE_BASE + 8 + (consumed & (TRACE_CAPACITY - 1)) * 8;
+            uint32_t word1 = backdoor_read_word(dut, entry + 4);
+            record({backdoor_read_word(dut, entry), (uint8_t)(word1 >> 24),
+                    (uint8_t)(word1 >> 16), (uint16_t)word1});
+        }
+    }
+
+    // Per-task CPU time (IRQ time excluded) and kernel time summary
+    void printSummary() const {
+        if (events.empty()) return;
+        uint64_t total = kernelCycles;
+        for (auto &task : taskCycles) total += task.second;
+
+        std::cout << "[TRACE] " << events.size() << " kernel events decoded";
+        if (dropped) std::cout << " (" << dropped << " dropped, ring overrun)";
+        std::cout << std::endl;
+        for (auto &task : taskCycles) {
+            std::cout << "[TRACE]   Task " << (int)task.first << ": " << std::setw(10) << task.second
+                      << " cycles (" << std::fixed << std::setprecision(1)
+                      << (total ? 100.0 * task.second / total : 0.0) << "%)" << std::endl;
+        }
+        std::cout << "[TRACE]   Kernel: " << std::setw(8) << kernelCycles << " cycles ("
+                  << std::fixed << std::setprecision(1) << (total ? 100.0 * kernelCycles / total : 0.0)
+                  << "%)" << std::endl;
+    }
+
+    // Chrome trace event format; timestamps in microseconds at the CPU clock (12.5 MHz by default)
+    void writeChromeTrace(const std::string &path) const {
+        if (events.empty()) return;
+        std::ofstream out(path);
+        out << "{\"traceEvents\":[\n";
+        bool first = true;
+        auto emit = [&](const std::string &json) {
+            out << (first ? "" : ",\n") << json;
+            first = false;
+        };
+        for (auto &slice : slices) {
+            emit("{\"name\":\"" + slice.name + "\",\"ph\":\"X\",\"pid\":0,\"tid\":" +
+                 std::to_string(slice.tid) + ",\"ts\":" + micros(slice.begin) +
+                 ",\"dur\":" + micros(slice.end - slice.begin) + "}");
+        }
+        for (auto &event : events) {
+            if (event.type != TRACE_SWITCH && event.type != TRACE_TASK_CREATE && event.type != TRACE_YIELD) continue;
+            std::string name = (event.type == TRACE_SWITCH) ? "switch -> " + std::to_string(event.arg) :
+                               (event.type == TRACE_YIELD)  ? "yield" : "create";
+            emit("{\"name\":\"" + name + "\",\"ph\":\"i\",\"s\":\"t\",\"pid\":0,\"tid\":" +
+                 std::to_string(event.task) + ",\"ts\":" + micros(event.cycle) + "}");
+        }
+        out << "\n]}\n";
+        std::cout << "[TRACE] Timeline written to " << path << std::endl;
+    }
+
+private:
+    struct Slice {
+        std::string name;
+        int         tid;
+        uint32_t    begin, end;
+    };
+
+    static const int IRQ_TID = 1000; // Separate timeline row for the kernel
+
+    void record(const Event &event) {
+        events.push_back(event);
+        switch (event.type) {
+            case TRACE_IRQ_ENTER:
+                if (haveMark) closeSlice("task " + std::to_string(event.task), event.task, event.cycle);
+                markCycle = event.cycle; haveMark = true;
+                break;
+            case TRACE_IRQ_EXIT:
+                if (haveMark) {
+                    kernelCycles += event.cycle - markCycle;
+                    slices.push_back({"irq", IRQ_TID, markCycle, event.cycle});
+                }
+                markCycle = event.cycle; haveMark = true;
+                break;
+            default:
+                if (!haveMark) { markCycle = event.cycle; haveMark = true; }
+                break;
+        }
+    }
+
+    void closeSlice(const std::string &name, int task, uint32_t cycle) {
+        taskCycles[task] += cycle - markCycle;
+        slices.push_back({name, task, markCycle, cycle});
+    }
+
+    static std::string micros(uint32_t cycles) {
+        return std::to_string(cycles / SOC_CPU_MHZ);
+    }
+
+    Vsoc_top *dut;
+    uint32_t consumed = 0;
+    uint64_t dropped  = 0;
+
+    std::vector<Event>  events;
+    std::vector<Slice>  slices;
+    std::map<int, uint64_t> taskCycles;
+    uint64_t kernelCycles = 0;
+    uint32_t markCycle    = 0;
+    bool     haveMark     = false;
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef LATENCY_MONITOR_H
+#define LATENCY_MONITOR_H
+
+#include <cstdint>
+#include <iostream>
+#include "latency_stats.h"
+#include "rv32_encoding.h"
+#include "symbol_table.h"
+
+/**
+ * @brief Measures every timer preemption in CPU cycles:
+ *   timer event -> first trap_vector instruction -> scheduler entry -> mret.
+ * Boundaries come from the firmware symbol table, so moving code around in
+ * crt0.s or changing the controller's trap timing shows up as numbers.
+ */
+class LatencyMonitor {
+public:
+    explicit LatencyMonitor(const SymbolTable &symbols)
+        : trapVector(symbols.address("trap_vector", 0x10)),
+          schedulerEntry(symbols.address("scheduler")) {}
+
+    // Hart 0's timer event fired
+    void onTimerEvent(uint64_t cycle) {
+        if (phase != Idle) abandoned++; // Previous preemption never reached mret
+        eventCycle = cycle;
+        phase      = WaitVector;
+    }
+
+    // Hart 0 committed an instruction
+    void onRetire(uint64_t cycle, uint32_t pc, uint32_t instruction) {
+        switch (phase) {
+            case WaitVector:
+                if (pc == trapVector) {
+                    toVector.add(cycle - eventCycle);
+                    vectorCycle = cycle;
+                    phase = WaitScheduler;
+                }
+                break;
+            case WaitScheduler:
+                if (pc == schedulerEntry) {
+                    toScheduler.add(cycle - eventCycle);
+                    phase = WaitReturn;
+                }
+                break;
+            case WaitReturn:
+                if (instruction == RV_MRET) {
+                    toReturn.add(cycle - eventCycle);
+                    handlerCycles += cycle - vectorCycle + 1;
+                    phase = Idle;
+                }
+                break;
+            case Idle:
+                break;
+        }
+    }
+
+    // Cycles spent from trap_vector through mret, summed over completed preemptions
+    uint64_t preemptionCycles() const { return handlerCycles; }
+    size_t   preemptions()      const { return toReturn.count(); }
+
+    void printReport() const {
+        std::cout << "[LAT] Preemption latency (CPU cycles from timer event)" << std::endl;
+        toVector.print();
+        toScheduler.print();
+        toReturn.print();
+        if (abandoned) std::cout << "[LAT] " << abandoned << " preemptions did not complete" << std::endl;
+    }
+
+private:
+    enum Phase { Idle, WaitVector, WaitScheduler, WaitReturn };
+
+    uint32_t trapVector, schedulerEntry;
+    Phase    phase         = Idle;
+    uint64_t eventCycle    = 0;
+    uint64_t vectorCycle   = 0;
+    uint64_t handlerCycles = 0;
+    uint64_t abandoned     = 0;
+
+    LatencyStats toVector    {"irq -> trap_vector"};
+    LatencyStats toScheduler {"irq -> scheduler()"};
+    LatencyStats toReturn    {"irq -> mret"};
+};
+
+#endif
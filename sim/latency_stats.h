@@ -0,0 +1,69 @@
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Sample collector reporting min/avg/p99/max and a log2 histogram.
+ * Samples are cycle counts; memory is one word per sample.
+ */
+class LatencyStats {
+public:
+    explicit LatencyStats(const std::string &name) : name(name) {}
+
+    void add(uint64_t cycles) { samples.push_back(cycles); }
+
+    size_t   count() const { return samples.size(); }
+    uint64_t min()   const { return samples.empty() ? 0 : *std::min_element(samples.begin(), samples.end()); }
+    uint64_t max()   const { return samples.empty() ? 0 : *std::max_element(samples.begin(), samples.end()); }
+
+    double average() const {
+        if (samples.empty()) return 0.0;
+        uint64_t sum = 0;
+        for (uint64_t s : samples) sum += s;
+        return (double)sum / samples.size();
+    }
+
+    uint64_t percentile(double fraction) const {
+        if (samples.empty()) return 0;
+        std::vector<uint64_t> sorted(samples);
+        size_t rank = (size_t)(fraction * (sorted.size() - 1) + 0.5);
+        std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+        return sorted[rank];
+    }
+
+    void print(std::ostream &out = std::cout) const {
+        out << "[LAT] " << std::left << std::setw(28) << name << std::right;
+        if (samples.empty()) {
+            out << " no samples" << std::endl;
+            return;
+        }
+        out << " n=" << std::setw(5) << count()
+            << "  min=" << std::setw(6) << min()
+            << "  avg=" << std::setw(9) << std::fixed << std::setprecision(1) << average()
+            << "  p99=" << std::setw(6) << percentile(0.99)
+            << "  max=" << std::setw(6) << max() << std::endl;
+
+        // Power-of-two buckets: [2^k, 2^(k+1))
+        std::vector<size_t> buckets(65, 0);
+        for (uint64_t s : samples) buckets[s ? 64 - __builtin_clzll(s) : 0]++;
+        size_t peak = *std::max_element(buckets.begin(), buckets.end());
+        for (size_t k = 0; k < buckets.size(); k++) {
+            if (!buckets[k]) continue;
+            uint64_t low = k ? (1ull << (k - 1)) : 0;
+            out << "[LAT]   >= " << std::setw(8) << low << " | "
+                << std::string((buckets[k] * 40 + peak - 1) / peak, '#') << " " << buckets[k] << std::endl;
+        }
+    }
+
+private:
+    std::string           name;
+    std::vector<uint64_t> samples;
+};
+
+#endif
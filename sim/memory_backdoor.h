@@ -0,0 +1,50 @@
+#ifndef MEMORY_BACKDOOR_H
+#define MEMORY_BACKDOOR_H
+
+#include <cstdint>
+#include <string>
+#include "Vsoc_top.h"
+#include "Vsoc_top___024root.h"
+#include "soc_config.h"
+
+// inst_mem keeps even and odd words in separate banks
+static inline uint32_t *backdoor_rom_word(Vsoc_top *dut, uint32_t index) {
+    uint32_t bankIndex = (index & (SOC_ROM_WORDS - 1)) >> 1;
+    return (index & 1) ? &dut->rootp->soc_top__DOT__u_rom__DOT__romOdd[bankIndex]
+                       : &dut->rootp->soc_top__DOT__u_rom__DOT__romEven[bankIndex];
+}
+
+/**
+ * @brief Zero-time access to the SoC memories from the testbench.
+ * Decodes addresses exactly like bus_interconnect: bit 29 selects RAM,
+ * everything else below MMIO is the instruction ROM.
+ */
+static inline uint32_t backdoor_read_word(Vsoc_top *dut, uint32_t address) {
+    uint32_t index = address >> 2;
+    if (address & 0x20000000) return dut->rootp->soc_top__DOT__u_ram__DOT__ramArray[index & (SOC_RAM_WORDS - 1)];
+    return *backdoor_rom_word(dut, index);
+}
+
+// Writes land immediately; ROM writes change the image the core fetches from (ICACHE_ENABLE=0)
+static inline void backdoor_write_word(Vsoc_top *dut, uint32_t address, uint32_t data) {
+    uint32_t index = address >> 2;
+    if (address & 0x20000000) dut->rootp->soc_top__DOT__u_ram__DOT__ramArray[index & (SOC_RAM_WORDS - 1)] = data;
+    else                      *backdoor_rom_word(dut, index) = data;
+}
+
+static inline uint8_t backdoor_read_byte(Vsoc_top *dut, uint32_t address) {
+    return (uint8_t)(backdoor_read_word(dut, address) >> ((address & 3) * 8));
+}
+
+// Reads a NUL-terminated string, bounded so a bad pointer cannot hang the harness
+static inline std::string backdoor_read_string(Vsoc_top *dut, uint32_t address, size_t maxLength = 4096) {
+    std::string text;
+    for (size_t i = 0; i < maxLength; i++) {
+        char c = (char)backdoor_read_byte(dut, address + i);
+        if (c == '\0') break;
+        text += c;
+    }
+    return text;
+}
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef PC_PROFILER_H
+#define PC_PROFILER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "rv32_encoding.h"
+#include "soc_config.h"
+#include "symbol_table.h"
+
+#define PROFILE_ROM_WORDS SOC_ROM_WORDS // Instruction ROM (4KB by default)
+
+/**
+ * @brief Instruction-retire profiler.
+ * The core retires one instruction per CPU cycle, so a per-word PC histogram
+ * is an exact cycle profile. Functions come from the symbol table and source
+ * lines from firmware/firmware.lines (addr2line output written by run.sh).
+ * With folded output enabled it also keeps a shadow call stack built from
+ * jal/jalr-to-ra and ret, for flamegraph.pl / speedscope.
+ */
+class PcProfiler {
+public:
+    PcProfiler(const SymbolTable &symbols, bool foldedStacks)
+        : symbols(symbols), foldedStacks(foldedStacks), pcHistogram(PROFILE_ROM_WORDS, 0) {
+        // Precompute word -> function so the per-cycle path is two array reads
+        wordFunction.resize(PROFILE_ROM_WORDS);
+        for (uint32_t word = 0; word < PROFILE_ROM_WORDS; word++) {
+            wordFunction[word] = internFunction(symbols.functionName(word * 4));
+        }
+        trapVector = symbols.address("trap_vector", 0x10);
+        loadLineTable("firmware/firmware.lines");
+    }
+
+    void onRetire(uint32_t pc, uint32_t instruction) {
+        uint32_t word = (pc >> 2) & (PROFILE_ROM_WORDS - 1);
+        pcHistogram[word]++;
+        totalRetired++;
+        if (!foldedStacks) return;
+
+        // Trap entry behaves like a call from the interrupted function
+        if (pc == trapVector && lastPc != trapVector) push(lastFunction);
+
+        stackCounts[stackKey(wordFunction[word])]++;
+
+        uint32_t opcode = RV_OPCODE(instruction);
+        if ((opcode == OP_JAL || opcode == OP_JALR) && RV_RD(instruction) == 1) push(wordFunction[word]);
+        else if (instruction == RV_RET || instruction == RV_MRET)              pop();
+
+        lastPc       = pc;
+        lastFunction = wordFunction[word];
+    }
+
+    void printFlatProfile(size_t topFunctions = 15, size_t topLines = 10) const {
+        if (!totalRetired) return;
+
+        std::map<int, uint64_t> perFunction;
+        for (uint32_t word = 0; word < PROFILE_ROM_WORDS; word++) perFunction[wordFunction[word]] += pcHistogram[word];
+
+        std::vector<std::pair<uint64_t, int>> ranked;
+        for (auto &entry : perFunction) if (entry.second) ranked.push_back({entry.second, entry.first});
+        std::sort(ranked.rbegin(), ranked.rend());
+
+        std::cout << "[PROF] Flat profile: " << totalRetired << " instructions retired" << std::endl;
+        std::cout << "[PROF]      %       cycles  function" << std::endl;
+        for (size_t i = 0; i < ranked.size() && i < topFunctions; i++) {
+            std::cout << "[PROF] " << std::setw(6) << std::fixed << std::setprecision(2)
+                      << 100.0 * ranked[i].first / totalRetired << "  " << std::setw(11) << ranked[i].first
+                      << "  " << functionNames[ranked[i].second] << std::endl;
+        }
+
+        std::vector<std::pair<uint64_t, uint32_t>> hotWords;
+        for (uint32_t word = 0; word < PROFILE_ROM_WORDS; word++) {
+            if (pcHistogram[word]) hotWords.push_back({pcHistogram[word], word});
+        }
+        std::sort(hotWords.rbegin(), hotWords.rend());
+
+        std::cout << "[PROF] Hottest instructions:" << std::endl;
+        for (size_t i = 0; i < hotWords.size() && i < topLines; i++) {
+            uint32_t word = hotWords[i].second;
+            std::cout << "[PROF]   0x" << std::hex << std::setw(8) << std::setfill('0') << word * 4
+                      << std::dec << std::setfill(' ') << "  " << std::setw(11) << hotWords[i].first
+                      << "  " << functionNames[wordFunction[word]];
+            if (word < lineTable.size() && !lineTable[word].empty()) std::cout << "  (" << lineTable[word] << ")";
+            std::cout << std::endl;
+        }
+    }
+
+    // One "caller;callee count" line per unique stack (Brendan Gregg's folded format)
+    void writeFoldedStacks(const std::string &path) const {
+        if (!foldedStacks || stackCounts.empty()) return;
+        std::ofstream out(path);
+        for (auto &entry : stackCounts) {
+            const std::vector<int> &frames = stacks[entry.first >> 16];
+            for (int frame : frames) out << functionNames[frame] << ";";
+            out << functionNames[entry.first & 0xFFFF] << " " << entry.second << "\n";
+        }
+        std::cout << "[PROF] Folded stacks written to " << path << std::endl;
+    }
+
+private:
+    static const size_t MAX_DEPTH = 32;
+
+    int internFunction(const std::string &name) {
+        auto it = functionIds.find(name);
+        if (it != functionIds.end()) return it->second;
+        functionNames.push_back(name);
+        return functionIds[name] = (int)functionNames.size() - 1;
+    }
+
+    // Stacks are interned so the per-cycle key is a single integer
+    uint64_t stackKey(int leaf) {
+        return ((uint64_t)currentStack << 16) | (uint32_t)leaf;
+    }
+
+    void push(int function) {
+        if (frames.size() >= MAX_DEPTH) return;
+        frames.push_back(function);
+        internStack();
+    }
+
+    void pop() {
+        if (!frames.empty()) frames.pop_back();
+        internStack();
+    }
+
+    void internStack() {
+        auto it = stackIds.find(frames);
+        if (it == stackIds.end()) {
+            stacks.push_back(frames);
+            it = stackIds.emplace(frames, (uint32_t)stacks.size() - 1).first;
+        }
+        currentStack = it->second;
+    }
+
+    // addr2line -a output: "0x..." line followed by "file:line" per address
+    void loadLineTable(const std::string &path) {
+        std::ifstream in(path);
+        std::string address, location;
+        while (std::getline(in, address) && std::getline(in, location)) {
+            uint32_t word = (uint32_t)(std::stoul(address, nullptr, 16) >> 2);
+            if (word >= PROFILE_ROM_WORDS) continue;
+            if (lineTable.size() <= word) lineTable.resize(word + 1);
+            if (location.find("??") == std::string::npos) lineTable[word] = location;
+        }
+    }
+
+    const SymbolTable &symbols;
+    bool               foldedStacks;
+
+    std::vector<uint64_t>    pcHistogram;
+    std::vector<int>         wordFunction;
+    std::vector<std::string> functionNames;
+    std::map<std::string, int> functionIds;
+    std::vector<std::string> lineTable;
+    uint64_t totalRetired = 0;
+
+    // Shadow call stack state (folded output only)
+    uint32_t trapVector   = 0x10;
+    uint32_t lastPc       = 0;
+    int      lastFunction = 0;
+    std::vector<int> frames;
+    std::vector<std::vector<int>> stacks{std::vector<int>()};
+    std::map<std::vector<int>, uint32_t> stackIds{{std::vector<int>(), 0}};
+    uint32_t currentStack = 0;
+    std::unordered_map<uint64_t, uint64_t> stackCounts;
+};
+
+#endif
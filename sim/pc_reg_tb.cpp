@@ -1,18 +1,10 @@
 #include <iostream>
-#include <verilated.h>
+#include "tb_framework.h"
 #include "Vpc_reg.h"
 
-// Helper to toggle clock
-void tick(Vpc_reg* top) {
-    top->clock = 0; top->eval();
-    top->clock = 1; top->eval(); // Rising Edge -> Update happens here
-}
-
 int main(int argc, char** argv) {
-    Verilated::commandArgs(argc, argv);
-    Vpc_reg* pc = new Vpc_reg;
-
-    std::cout << "[TEST] Starting Program Counter Verification...\n";
+    Testbench<Vpc_reg> tb(argc, argv, "Program Counter");
+    Vpc_reg* pc = tb.dut();
 
     // ==========================================
     // TEST 1: RESET BEHAVIOR
@@ -23,16 +15,11 @@ int main(int argc, char** argv) {
     pc->enable = 1;
     
     // Clock it
-    pc->clock = 0; pc->eval();
-    pc->clock = 1; pc->eval();
+    tb.tick();
 
     // Check: PC should be 0, ignoring the input
-    if (pc->programCounter == 0) {
-        std::cout << "[PASS] Reset Logic: PC cleared to 0.\n";
-    } else {
-        std::cout << "[FAIL] Reset Logic Failed. PC is: " << std::hex << pc->programCounter << "\n";
-        return 1;
-    }
+    tb.check(pc->programCounter == 0, "Reset Logic: PC cleared to 0.",
+             "Reset Logic Failed. PC is: " + tb_hex(pc->programCounter));
 
     // Release Reset
     pc->resetActiveLow = 1;
@@ -44,14 +31,10 @@ int main(int argc, char** argv) {
     pc->enable = 1;
     pc->nextProgramCounter = 0x00000004;
     
-    tick(pc);
+    tb.tick(); // Rising Edge -> Update happens here
 
-    if (pc->programCounter == 0x00000004) {
-        std::cout << "[PASS] Normal Update: PC advanced to 0x4.\n";
-    } else {
-        std::cout << "[FAIL] Normal Update Failed. Expected 0x4, Got: " << pc->programCounter << "\n";
-        return 1;
-    }
+    tb.check(pc->programCounter == 0x00000004, "Normal Update: PC advanced to 0x4.",
+             "Normal Update Failed. Expected 0x4, Got: " + tb_hex(pc->programCounter));
 
     // ==========================================
     // TEST 3: STALL LOGIC (CRITICAL)
@@ -62,14 +45,10 @@ int main(int argc, char** argv) {
     pc->enable = 0; // FREEZE!
     pc->nextProgramCounter = 0x00000008;
     
-    tick(pc);
+    tb.tick();
 
-    if (pc->programCounter == 0x00000004) {
-        std::cout << "[PASS] Stall Logic: PC successfully frozen at 0x4 despite input change.\n";
-    } else {
-        std::cout << "[FAIL] Stall Logic Failed! PC updated when disabled. Got: " << pc->programCounter << "\n";
-        return 1;
-    }
+    tb.check(pc->programCounter == 0x00000004, "Stall Logic: PC successfully frozen at 0x4 despite input change.",
+             "Stall Logic Failed! PC updated when disabled. Got: " + tb_hex(pc->programCounter));
 
     // ==========================================
     // TEST 4: RESUME
@@ -77,18 +56,9 @@ int main(int argc, char** argv) {
     // Scenario: Hazard cleared. Enable=1. PC should finally catch up.
     
     pc->enable = 1; // Unfreeze
-    tick(pc);
+    tb.tick();
 
-    if (pc->programCounter == 0x00000008) {
-        std::cout << "[PASS] Resume: PC updated to 0x8 after stall.\n";
-    } else {
-        std::cout << "[FAIL] Resume Failed.\n";
-        return 1;
-    }
+    tb.check(pc->programCounter == 0x00000008, "Resume: PC updated to 0x8 after stall.", "Resume Failed.");
 
-    std::cout << "------------------------------------------\n";
-    std::cout << "[SUCCESS] Program Counter Verified.\n";
-
-    delete pc;
-    return 0;
-}
\ No newline at end of file
+    return tb.finish();
+}
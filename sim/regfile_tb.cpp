@@ -1,18 +1,10 @@
 #include <iostream>
-#include <verilated.h>
+#include "tb_framework.h"
 #include "Vregfile.h"
 
-// Helper to toggle clock
-void tick(Vregfile* top) {
-    top->clock = 0; top->eval();
-    top->clock = 1; top->eval(); // Write happens on Rising Edge
-}
-
 int main(int argc, char** argv) {
-    Verilated::commandArgs(argc, argv);
-    Vregfile* rf = new Vregfile;
-
-    std::cout << "[TEST] Starting Register File Verification...\n";
+    Testbench<Vregfile> tb(argc, argv, "Register File");
+    Vregfile* rf = tb.dut();
 
     // ==========================================
     // TEST 1: THE x0 IMMUTABILITY CHECK (CRITICAL)
@@ -24,18 +16,14 @@ int main(int argc, char** argv) {
     rf->writeAddress = 0; // x0
     rf->writeData = 0xFFFFFFFF;
     
-    tick(rf); // Attempt write
+    tb.tick(); // Attempt write (writes happen on the rising edge)
 
     // Check Port 0
     rf->readAddress0 = 0;
     rf->eval();
 
-    if (rf->readData0 == 0) {
-        std::cout << "[PASS] Register x0 Immutability: Write ignored, read returns 0.\n";
-    } else {
-        std::cout << "[FAIL] FATAL ERROR: x0 was overwritten! Got: " << std::hex << rf->readData0 << "\n";
-        return 1;
-    }
+    tb.check(rf->readData0 == 0, "Register x0 Immutability: Write ignored, read returns 0.",
+             "FATAL ERROR: x0 was overwritten! Got: " + tb_hex(rf->readData0));
 
     // ==========================================
     // TEST 2: BASIC READ/WRITE (x1)
@@ -46,18 +34,14 @@ int main(int argc, char** argv) {
     rf->writeAddress = 1;
     rf->writeData = 0xDEADBEEF;
     
-    tick(rf); // Write happens
+    tb.tick(); // Write happens
 
     // Read back on Port 0
     rf->readAddress0 = 1;
     rf->eval();
 
-    if (rf->readData0 == 0xDEADBEEF) {
-        std::cout << "[PASS] Basic Read/Write: x1 updated correctly.\n";
-    } else {
-        std::cout << "[FAIL] x1 Write Failed. Got: " << std::hex << rf->readData0 << "\n";
-        return 1;
-    }
+    tb.check(rf->readData0 == 0xDEADBEEF, "Basic Read/Write: x1 updated correctly.",
+             "x1 Write Failed. Got: " + tb_hex(rf->readData0));
 
     // ==========================================
     // TEST 3: DUAL PORT READ
@@ -68,18 +52,14 @@ int main(int argc, char** argv) {
     
     rf->writeAddress = 2;
     rf->writeData = 0xCAFEBABE;
-    tick(rf);
+    tb.tick();
 
     rf->readAddress0 = 1; // Expect DEADBEEF
     rf->readAddress1 = 2; // Expect CAFEBABE
     rf->eval();
 
-    if ((rf->readData0 == 0xDEADBEEF) && (rf->readData1 == 0xCAFEBABE)) {
-        std::cout << "[PASS] Dual Port Read: Simultaneously read x1 and x2.\n";
-    } else {
-        std::cout << "[FAIL] Dual Port Read Failed.\n";
-        return 1;
-    }
+    tb.check((rf->readData0 == 0xDEADBEEF) && (rf->readData1 == 0xCAFEBABE),
+             "Dual Port Read: Simultaneously read x1 and x2.", "Dual Port Read Failed.");
 
     // ==========================================
     // TEST 4: WRITE ENABLE PROTECTION
@@ -91,21 +71,37 @@ int main(int argc, char** argv) {
     rf->writeAddress = 2;
     rf->writeData = 0xBADF00D;
     
-    tick(rf);
+    tb.tick();
 
     rf->readAddress1 = 2;
     rf->eval();
 
-    if (rf->readData1 == 0xCAFEBABE) {
-        std::cout << "[PASS] Write Enable Protection: Data preserved when Enable=0.\n";
-    } else {
-        std::cout << "[FAIL] Protection Failed! x2 overwritten when disabled.\n";
-        return 1;
-    }
-
-    std::cout << "------------------------------------------\n";
-    std::cout << "[SUCCESS] Register File Verified.\n";
+    tb.check(rf->readData1 == 0xCAFEBABE, "Write Enable Protection: Data preserved when Enable=0.",
+             "Protection Failed! x2 overwritten when disabled.");
 
-    delete rf;
-    return 0;
-}
\ No newline at end of file
+    // ==========================================
+    // TEST 5: RANDOM TRAFFIC AGAINST A SHADOW COPY
+    // ==========================================
+    // Random writes (enable on or off, x0 included) and two random reads per
+    // cycle, checked against a C++ array of the 32 registers.
+    uint32_t shadow[32] = {0};
+    for (int index = 1; index < 32; index++) {
+        rf->registerWriteEnable = 1; rf->writeAddress = index; rf->writeData = 0;
+        tb.tick();
+    }
+    tb.vectors("Random Read/Write Traffic", 200000, [&](uint64_t) {
+        uint32_t control = tb.random32();
+        rf->registerWriteEnable = control & 1;
+        rf->writeAddress        = (control >> 1) & 31;
+        rf->writeData           = tb.random32();
+        if ((control & 1) && rf->writeAddress) shadow[rf->writeAddress] = rf->writeData;
+        tb.tick();
+
+        rf->readAddress0 = (control >> 6) & 31;
+        rf->readAddress1 = (control >> 11) & 31;
+        rf->eval();
+        return rf->readData0 == shadow[rf->readAddress0] && rf->readData1 == shadow[rf->readAddress1];
+    });
+
+    return tb.finish();
+}
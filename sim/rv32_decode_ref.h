@@ -0,0 +1,151 @@
+#ifndef RV32_DECODE_REF_H
+#define RV32_DECODE_REF_H
+
+#include <cstdint>
+#include "rv32_disasm.h"
+#include "rv32_encoding.h"
+
+// --- REFERENCE DECODER ---
+// What controller.sv and imm_gen.sv promise for every input, written from
+// the instruction tables rather than from the RTL's case structure. It
+// keeps the core's documented simplifications: SYSTEM always decodes as
+// MRET and RV32A ignores funct3. Branch conditions and load/store widths
+// are resolved in cpu_core from funct3, not here. Reserved encodings decode
+// to whatever base op their funct3 names, or ADD for an unknown shift form.
+
+// aluControl codes (alu.sv)
+enum : uint8_t {
+    ALU_ADD, ALU_SUB, ALU_AND, ALU_OR, ALU_XOR, ALU_SLT, ALU_ANDN, ALU_ORN, ALU_XNOR,
+    ALU_CLZ, ALU_CTZ, ALU_CPOP, ALU_ROL, ALU_ROR, ALU_MIN, ALU_MAX, ALU_MINU, ALU_MAXU,
+    ALU_SH1ADD, ALU_SH2ADD, ALU_SH3ADD, ALU_REV8, ALU_ORC_B, ALU_SEXT_B, ALU_SEXT_H, ALU_ZEXT_H,
+    ALU_SLTU, ALU_SLL, ALU_SRL, ALU_SRA,
+};
+
+struct DecodeRef {
+    bool    registerWrite;
+    bool    aluImmediate;     // aluInputSource
+    bool    memoryWrite;
+    bool    resultMemory;     // resultSource
+    bool    branch;
+    uint8_t alu;
+    bool    csrWrite;
+    bool    trap;
+    bool    isReturn;
+    bool    atomic;
+    bool    loadReserve;
+    bool    storeConditional;
+    bool    custom;
+
+    bool operator==(const DecodeRef &other) const {
+        return registerWrite == other.registerWrite && aluImmediate == other.aluImmediate &&
+               memoryWrite == other.memoryWrite && resultMemory == other.resultMemory && branch == other.branch &&
+               alu == other.alu && csrWrite == other.csrWrite && trap == other.trap && isReturn == other.isReturn &&
+               atomic == other.atomic && loadReserve == other.loadReserve &&
+               storeConditional == other.storeConditional && custom == other.custom;
+    }
+};
+
+// funct7-qualified encodings on OP (register) and OP-IMM: the base shifts
+// and Zba/Zbb; rs2 < 0 matches any rs2 field
+struct BitmanipRef { bool registerForm, immediateForm; uint8_t funct3, funct7; int8_t rs2; uint8_t alu; };
+
+static const BitmanipRef RV_BITMANIP_REF[] = {
+    {true,  true,  1, 0x00, -1,   ALU_SLL},    {true,  true,  5, 0x00, -1,   ALU_SRL},
+    {true,  true,  5, 0x20, -1,   ALU_SRA},
+    {true,  false, 7, 0x20, -1,   ALU_ANDN},   {true,  false, 6, 0x20, -1,   ALU_ORN},
+    {true,  false, 4, 0x20, -1,   ALU_XNOR},   {true,  false, 4, 0x05, -1,   ALU_MIN},
+    {true,  false, 6, 0x05, -1,   ALU_MAX},    {true,  false, 5, 0x05, -1,   ALU_MINU},
+    {true,  false, 7, 0x05, -1,   ALU_MAXU},   {true,  false, 2, 0x10, -1,   ALU_SH1ADD},
+    {true,  false, 4, 0x10, -1,   ALU_SH2ADD}, {true,  false, 6, 0x10, -1,   ALU_SH3ADD},
+    {true,  false, 4, 0x04, -1,   ALU_ZEXT_H}, {true,  false, 1, 0x30, -1,   ALU_ROL},
+    {true,  true,  5, 0x30, -1,   ALU_ROR},    {false, true,  1, 0x30, 0,    ALU_CLZ},
+    {false, true,  1, 0x30, 1,    ALU_CTZ},    {false, true,  1, 0x30, 2,    ALU_CPOP},
+    {false, true,  1, 0x30, 4,    ALU_SEXT_B}, {false, true,  1, 0x30, 5,    ALU_SEXT_H},
+    {false, true,  5, 0x34, 0x18, ALU_REV8},   {false, true,  5, 0x14, 0x07, ALU_ORC_B},
+};
+
+// ALU operation of an OP / OP-IMM instruction
+static inline uint8_t rv32_ref_alu(bool registerForm, uint32_t funct3, uint32_t funct7, uint32_t rs2) {
+    for (const BitmanipRef &op : RV_BITMANIP_REF) {
+        if ((registerForm ? op.registerForm : op.immediateForm) && op.funct3 == funct3 && op.funct7 == funct7 &&
+            (op.rs2 < 0 || (uint32_t)op.rs2 == rs2))
+            return op.alu;
+    }
+    // Base ops without a funct7 qualifier; a shift funct3 with an unknown funct7 decodes to ADD
+    static const uint8_t base[8] = {ALU_ADD, ALU_ADD, ALU_SLT, ALU_SLTU, ALU_XOR, ALU_ADD, ALU_OR, ALU_AND};
+    if (funct3 == 0 && registerForm && (funct7 & 0x20)) return ALU_SUB;
+    return base[funct3];
+}
+
+// controller.sv outputs for one set of decode inputs
+static inline DecodeRef rv32_ref_control(uint32_t opcode, uint32_t funct3, uint32_t funct7, uint32_t rs2, bool trapRequest) {
+    DecodeRef ref = {};
+    if (trapRequest) {          // An interrupt replaces the instruction entirely
+        ref.trap     = true;
+        ref.csrWrite = true;
+        return ref;
+    }
+    switch (opcode) {
+        case OP_R_TYPE:
+            ref.registerWrite = true;
+            ref.alu           = rv32_ref_alu(true, funct3, funct7, rs2);
+            break;
+        case OP_I_TYPE:
+            ref.registerWrite = ref.aluImmediate = true;
+            ref.alu           = rv32_ref_alu(false, funct3, funct7, rs2);
+            break;
+        case OP_LOAD:
+            ref.registerWrite = ref.aluImmediate = ref.resultMemory = true;
+            break;
+        case OP_STORE:
+            ref.memoryWrite = ref.aluImmediate = true;
+            break;
+        case OP_BRANCH:         // The condition is evaluated in cpu_core; the ALU subtracts
+            ref.branch = true;
+            ref.alu    = ALU_SUB;
+            break;
+        case OP_LUI:
+        case OP_AUIPC:
+            ref.registerWrite = ref.aluImmediate = true;
+            break;
+        case OP_JAL:
+        case OP_JALR:
+            ref.registerWrite = ref.branch = ref.aluImmediate = true;
+            break;
+        case OP_SYSTEM:
+            ref.isReturn = true;
+            break;
+        case OP_AMO:            // Address is rs1 + 0; rd receives the old word (SC.W: the status)
+            ref.atomic = ref.registerWrite = ref.aluImmediate = true;
+            if ((funct7 >> 2) == 0x02) {
+                ref.loadReserve = ref.resultMemory = true;
+            } else if ((funct7 >> 2) == 0x03) {
+                ref.storeConditional = ref.memoryWrite = true;
+            } else {
+                ref.resultMemory = ref.memoryWrite = true;
+            }
+            break;
+        case OP_CUSTOM0:
+        case OP_CUSTOM1:
+            ref.registerWrite = ref.custom = true;
+            break;
+    }
+    return ref;
+}
+
+// imm_gen.sv output: the format's immediate, or 0 for opcodes without one the core uses
+static inline uint32_t rv32_ref_immediate(uint32_t insn) {
+    switch (RV_OPCODE(insn)) {
+        case OP_I_TYPE:
+        case OP_LOAD:
+        case OP_JALR:   return (uint32_t)rv32_imm_i(insn);
+        case OP_STORE:  return (uint32_t)rv32_imm_s(insn);
+        case OP_BRANCH: return (uint32_t)rv32_imm_b(insn);
+        case OP_LUI:
+        case OP_AUIPC:  return insn & 0xFFFFF000;
+        case OP_JAL:    return (uint32_t)rv32_imm_j(insn);
+        default:        return 0;
+    }
+}
+
+#endif
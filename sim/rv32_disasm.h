@@ -0,0 +1,173 @@
+#ifndef RV32_DISASM_H
+#define RV32_DISASM_H
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include "rv32_encoding.h"
+
+// --- RV32 DISASSEMBLER ---
+// One instruction word (already expanded from RVC) to GNU-style assembly
+// with ABI register names. Covers what the firmware is built with
+// (rv32ia_zba_zbb plus M for completeness), mret, and the crc32 custom-0
+// encodings; anything else prints as .word.
+
+static const char *const RV_ABI_NAMES[32] = {
+    "zero", "ra", "sp", "gp", "tp", "t0", "t1", "t2", "s0", "s1", "a0", "a1", "a2", "a3", "a4", "a5",
+    "a6", "a7", "s2", "s3", "s4", "s5", "s6", "s7", "s8", "s9", "s10", "s11", "t3", "t4", "t5", "t6"};
+
+static inline int32_t rv32_imm_i(uint32_t insn) { return (int32_t)insn >> 20; }
+static inline int32_t rv32_imm_s(uint32_t insn) {
+    return ((int32_t)(insn & 0xFE000000) >> 20) | ((insn >> 7) & 0x1F);
+}
+static inline int32_t rv32_imm_b(uint32_t insn) {
+    return ((int32_t)(insn & 0x80000000) >> 19) | ((insn & 0x80) << 4) | ((insn >> 20) & 0x7E0) | ((insn >> 7) & 0x1E);
+}
+static inline int32_t rv32_imm_j(uint32_t insn) {
+    return ((int32_t)(insn & 0x80000000) >> 11) | (insn & 0xFF000) | ((insn >> 9) & 0x800) | ((insn >> 20) & 0x7FE);
+}
+
+static inline std::string rv32_format(const char *format, ...) __attribute__((format(printf, 1, 2)));
+static inline std::string rv32_format(const char *format, ...) {
+    char buffer[96];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    return buffer;
+}
+
+static inline std::string rv32_disasm(uint32_t insn, uint32_t pc) {
+    const char *rd  = RV_ABI_NAMES[RV_RD(insn)];
+    const char *rs1 = RV_ABI_NAMES[RV_RS1(insn)];
+    const char *rs2 = RV_ABI_NAMES[RV_RS2(insn)];
+    uint32_t funct3 = RV_FUNCT3(insn), funct7 = RV_FUNCT7(insn);
+
+    if (insn == RV_MRET) return "mret";
+    if (insn == RV_RET)  return "ret";
+    if (insn == 0x00000013) return "nop";
+
+    switch (RV_OPCODE(insn)) {
+        case OP_LUI:
+            return rv32_format("lui     %s, 0x%x", rd, insn >> 12);
+        case OP_AUIPC:
+            return rv32_format("auipc   %s, 0x%x", rd, insn >> 12);
+        case OP_JAL: {
+            uint32_t target = pc + rv32_imm_j(insn);
+            if (RV_RD(insn) == 0) return rv32_format("j       0x%x", target);
+            return rv32_format("jal     %s, 0x%x", rd, target);
+        }
+        case OP_JALR:
+            return rv32_format("jalr    %s, %d(%s)", rd, rv32_imm_i(insn), rs1);
+        case OP_BRANCH: {
+            static const char *const names[8] = {"beq", "bne", "?", "?", "blt", "bge", "bltu", "bgeu"};
+            if (names[funct3][0] == '?') break;
+            return rv32_format("%-7s %s, %s, 0x%x", names[funct3], rs1, rs2, pc + rv32_imm_b(insn));
+        }
+        case OP_LOAD: {
+            static const char *const names[8] = {"lb", "lh", "lw", "?", "lbu", "lhu", "?", "?"};
+            if (names[funct3][0] == '?') break;
+            return rv32_format("%-7s %s, %d(%s)", names[funct3], rd, rv32_imm_i(insn), rs1);
+        }
+        case OP_STORE: {
+            static const char *const names[8] = {"sb", "sh", "sw", "?", "?", "?", "?", "?"};
+            if (names[funct3][0] == '?') break;
+            return rv32_format("%-7s %s, %d(%s)", names[funct3], rs2, rv32_imm_s(insn), rs1);
+        }
+        case OP_I_TYPE: {
+            int32_t  imm   = rv32_imm_i(insn);
+            uint32_t shamt = RV_RS2(insn);
+            switch (funct3) {
+                case 0: if (RV_RS1(insn) == 0) return rv32_format("li      %s, %d", rd, imm);
+                        if (imm == 0)          return rv32_format("mv      %s, %s", rd, rs1);
+                        return rv32_format("addi    %s, %s, %d", rd, rs1, imm);
+                case 2: return rv32_format("slti    %s, %s, %d", rd, rs1, imm);
+                case 3: return rv32_format("sltiu   %s, %s, %d", rd, rs1, imm);
+                case 4: return rv32_format("xori    %s, %s, %d", rd, rs1, imm);
+                case 6: return rv32_format("ori     %s, %s, %d", rd, rs1, imm);
+                case 7: return rv32_format("andi    %s, %s, %d", rd, rs1, imm);
+                case 1:
+                    if (funct7 == 0x00) return rv32_format("slli    %s, %s, %u", rd, rs1, shamt);
+                    if (funct7 == 0x30) {   // Zbb unary
+                        static const char *const names[8] = {"clz", "ctz", "cpop", "?", "sext.b", "sext.h", "?", "?"};
+                        if (shamt < 8 && names[shamt][0] != '?') return rv32_format("%-7s %s, %s", names[shamt], rd, rs1);
+                    }
+                    break;
+                case 5:
+                    if (funct7 == 0x00) return rv32_format("srli    %s, %s, %u", rd, rs1, shamt);
+                    if (funct7 == 0x20) return rv32_format("srai    %s, %s, %u", rd, rs1, shamt);
+                    if (funct7 == 0x30) return rv32_format("rori    %s, %s, %u", rd, rs1, shamt);
+                    if ((insn >> 20) == 0x287) return rv32_format("orc.b   %s, %s", rd, rs1);
+                    if ((insn >> 20) == 0x698) return rv32_format("rev8    %s, %s", rd, rs1);
+                    break;
+            }
+            break;
+        }
+        case OP_R_TYPE: {
+            const char *name = nullptr;
+            if (funct7 == 0x00) {
+                static const char *const names[8] = {"add", "sll", "slt", "sltu", "xor", "srl", "or", "and"};
+                name = names[funct3];
+            } else if (funct7 == 0x20) {
+                static const char *const names[8] = {"sub", nullptr, nullptr, nullptr, "xnor", "sra", "orn", "andn"};
+                name = names[funct3];
+            } else if (funct7 == 0x01) {
+                static const char *const names[8] = {"mul", "mulh", "mulhsu", "mulhu", "div", "divu", "rem", "remu"};
+                name = names[funct3];
+            } else if (funct7 == 0x10) {
+                static const char *const names[8] = {nullptr, nullptr, "sh1add", nullptr, "sh2add", nullptr, "sh3add", nullptr};
+                name = names[funct3];
+            } else if (funct7 == 0x05) {
+                static const char *const names[8] = {nullptr, nullptr, nullptr, nullptr, "min", "minu", "max", "maxu"};
+                name = names[funct3];
+            } else if (funct7 == 0x30) {
+                static const char *const names[8] = {nullptr, "rol", nullptr, nullptr, nullptr, "ror", nullptr, nullptr};
+                name = names[funct3];
+            } else if (funct7 == 0x04 && funct3 == 4 && RV_RS2(insn) == 0) {
+                return rv32_format("zext.h  %s, %s", rd, rs1);
+            }
+            if (name) return rv32_format("%-7s %s, %s, %s", name, rd, rs1, rs2);
+            break;
+        }
+        case OP_AMO: {
+            if (funct3 != 2) break;
+            const char *order = (funct7 & 0x3) == 0x3 ? ".aqrl" : (funct7 & 0x2) ? ".aq" : (funct7 & 0x1) ? ".rl" : "";
+            switch (funct7 >> 2) {
+                case 0x02: return rv32_format("lr.w%s %s, (%s)", order, rd, rs1);
+                case 0x03: return rv32_format("sc.w%s %s, %s, (%s)", order, rd, rs2, rs1);
+                default: {
+                    static const char *const names[32] = {
+                        "amoadd.w", "amoswap.w", nullptr, nullptr, "amoxor.w", nullptr, nullptr, nullptr,
+                        "amoor.w", nullptr, nullptr, nullptr, "amoand.w", nullptr, nullptr, nullptr,
+                        "amomin.w", nullptr, nullptr, nullptr, "amomax.w", nullptr, nullptr, nullptr,
+                        "amominu.w", nullptr, nullptr, nullptr, "amomaxu.w", nullptr, nullptr, nullptr};
+                    const char *name = names[funct7 >> 2];
+                    if (name) return rv32_format("%s%s %s, %s, (%s)", name, order, rd, rs2, rs1);
+                }
+            }
+            break;
+        }
+        case 0x0F:
+            return (funct3 == 1) ? "fence.i" : "fence";
+        case OP_SYSTEM:
+            if (insn == 0x00000073) return "ecall";
+            if (insn == 0x00100073) return "ebreak";
+            if (insn == 0x10500073) return "wfi";
+            if (funct3 != 0 && funct3 != 4) {
+                static const char *const names[8] = {nullptr, "csrrw", "csrrs", "csrrc", nullptr, "csrrwi", "csrrsi", "csrrci"};
+                if (funct3 < 4) return rv32_format("%-7s %s, 0x%x, %s", names[funct3], rd, insn >> 20, rs1);
+                return rv32_format("%-7s %s, 0x%x, %u", names[funct3], rd, insn >> 20, RV_RS1(insn));
+            }
+            break;
+        case OP_CUSTOM0:
+            if (funct7 == 0 && funct3 == 0) return rv32_format("crc32.b %s, %s, %s", rd, rs1, rs2);
+            if (funct7 == 0 && funct3 == 2) return rv32_format("crc32.w %s, %s, %s", rd, rs1, rs2);
+            return rv32_format("custom0 %s, %s, %s (f3=%u f7=0x%x)", rd, rs1, rs2, funct3, funct7);
+        case OP_CUSTOM1:
+            return rv32_format("custom1 %s, %s, %s (f3=%u f7=0x%x)", rd, rs1, rs2, funct3, funct7);
+    }
+    return rv32_format(".word   0x%08x", insn);
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef RV32_ENCODING_H
+#define RV32_ENCODING_H
+
+#include <cstdint>
+
+// --- FIXED INSTRUCTION WORDS ---
+#define RV_MRET   0x30200073 // mret
+#define RV_RET    0x00008067 // jalr x0, 0(ra)
+#define RV_J_SELF 0x0000006F // jal x0, 0 ('j .', also C.J 0 expanded)
+
+// --- MAJOR OPCODES (instruction[6:0]) ---
+#define OP_R_TYPE  0x33
+#define OP_I_TYPE  0x13
+#define OP_LOAD    0x03
+#define OP_STORE   0x23
+#define OP_BRANCH  0x63
+#define OP_LUI     0x37
+#define OP_AUIPC   0x17
+#define OP_JAL     0x6F
+#define OP_JALR    0x67
+#define OP_SYSTEM  0x73
+#define OP_AMO     0x2F // RV32A: LR/SC and AMO*.W
+#define OP_CUSTOM0 0x0B // Accelerator port (cpu_core.sv)
+#define OP_CUSTOM1 0x2B
+
+// --- FIELD EXTRACTION ---
+#define RV_OPCODE(insn) ((insn) & 0x7F)
+#define RV_RD(insn)     (((insn) >> 7) & 0x1F)
+#define RV_FUNCT3(insn) (((insn) >> 12) & 0x7)
+#define RV_RS1(insn)    (((insn) >> 15) & 0x1F)
+#define RV_RS2(insn)    (((insn) >> 20) & 0x1F)
+#define RV_FUNCT7(insn) (((insn) >> 25) & 0x7F)
+
+// --- ENCODERS (immediates are byte offsets / sign-extended values) ---
+static inline uint32_t rv32_enc_r(uint32_t funct7, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode) {
+    return (funct7 << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
+}
+static inline uint32_t rv32_enc_i(int32_t imm, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode) {
+    return ((uint32_t)imm << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
+}
+static inline uint32_t rv32_enc_s(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t funct3) {
+    return (((uint32_t)imm >> 5 & 0x7F) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (((uint32_t)imm & 0x1F) << 7) | OP_STORE;
+}
+static inline uint32_t rv32_enc_b(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t funct3) {
+    uint32_t u = (uint32_t)imm;
+    return ((u >> 12 & 1) << 31) | ((u >> 5 & 0x3F) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) |
+           ((u >> 1 & 0xF) << 8) | ((u >> 11 & 1) << 7) | OP_BRANCH;
+}
+static inline uint32_t rv32_enc_u(uint32_t upper, uint32_t rd, uint32_t opcode) {   // upper = imm[31:12]
+    return (upper << 12) | (rd << 7) | opcode;
+}
+static inline uint32_t rv32_enc_j(int32_t imm, uint32_t rd) {
+    uint32_t u = (uint32_t)imm;
+    return ((u >> 20 & 1) << 31) | ((u >> 1 & 0x3FF) << 21) | ((u >> 11 & 1) << 20) | ((u >> 12 & 0xFF) << 12) |
+           (rd << 7) | OP_JAL;
+}
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef RV32_ISS_H
+#define RV32_ISS_H
+
+#include <cstdint>
+#include <vector>
+#include "rv32_disasm.h"
+#include "rv32_encoding.h"
+
+/**
+ * @brief Instruction-set model of one hart: RV32I, the A extension and Zba/Zbb.
+ * It is the architectural reference for differential runs against
+ * Vsoc_top: step() executes one instruction and returns what it committed.
+ * The fields are the ones the SoC's retire monitor reports, so the two can
+ * be compared commit by commit. Memory is decoded like bus_interconnect:
+ * bit 30 selects MMIO (virtual hooks), bit 29 RAM, anything else the ROM,
+ * which ignores writes. Compressed encodings, CSRs and traps are not
+ * modelled; such an instruction comes back with illegal set and the
+ * model does not advance.
+ */
+class Rv32Iss {
+public:
+    struct Commit {
+        uint32_t pc;
+        uint32_t instruction;
+        bool     registerWrite;   // rd != x0 written
+        uint32_t registerData;
+        bool     memoryRead;
+        bool     memoryWrite;     // Attempted: a failing SC.W still reports its store
+        uint32_t memoryAddress;   // Effective (byte) address
+        uint32_t memoryData;      // Store data: rs2 shifted into its byte lanes, or the new word of an AMO
+        bool     illegal;
+    };
+
+    // Word counts must be powers of two; addresses wrap like the RTL arrays
+    Rv32Iss(size_t romWords, size_t ramWords) : rom(romWords), ram(ramWords) {}
+    virtual ~Rv32Iss() = default;
+
+    // --- MMIO HOOKS (word-aligned address) ---
+    virtual uint32_t loadMmio(uint32_t address) { (void)address; return 0; }
+    virtual void storeMmio(uint32_t address, uint32_t data) { (void)address; (void)data; }
+
+    Commit step() {
+        Commit commit = {};
+        commit.pc = pc;
+        uint32_t insn = commit.instruction = loadWord(pc);
+        uint32_t rd = RV_RD(insn), funct3 = RV_FUNCT3(insn), funct7 = RV_FUNCT7(insn);
+        uint32_t a = x[RV_RS1(insn)], b = x[RV_RS2(insn)];
+        uint32_t next = pc + 4, value = 0;
+        bool     write = true;
+
+        if ((pc & 3) || (insn & 3) != 3) return illegal(commit);
+
+        switch (RV_OPCODE(insn)) {
+            case OP_LUI:  value = insn & 0xFFFFF000; break;
+            case OP_AUIPC: value = pc + (insn & 0xFFFFF000); break;
+            case OP_JAL:  value = next; next = pc + rv32_imm_j(insn); break;
+            case OP_JALR: value = next; next = (a + rv32_imm_i(insn)) & ~1u; break;
+            case OP_BRANCH: {
+                bool taken;
+                switch (funct3) {
+                    case 0: taken = a == b; break;
+                    case 1: taken = a != b; break;
+                    case 4: taken = (int32_t)a < (int32_t)b; break;
+                    case 5: taken = (int32_t)a >= (int32_t)b; break;
+                    case 6: taken = a < b; break;
+                    case 7: taken = a >= b; break;
+                    default: return illegal(commit);
+                }
+                if (taken) next = pc + rv32_imm_b(insn);
+                write = false;
+                break;
+            }
+            case OP_LOAD: {
+                uint32_t address = a + rv32_imm_i(insn);
+                uint32_t size    = 1u << (funct3 & 3);
+                if (funct3 == 3 || funct3 > 5 || (address & (size - 1))) return illegal(commit);
+                uint32_t word = loadWord(address) >> ((address & 3) * 8);
+                switch (funct3) {
+                    case 0: value = (uint32_t)(int8_t)word;  break;
+                    case 1: value = (uint32_t)(int16_t)word; break;
+                    case 2: value = word;                    break;
+                    case 4: value = word & 0xFF;             break;
+                    case 5: value = word & 0xFFFF;           break;
+                }
+                commit.memoryRead    = true;
+                commit.memoryAddress = address;
+                break;
+            }
+            case OP_STORE: {
+                uint32_t address = a + rv32_imm_s(insn);
+                uint32_t size    = 1u << funct3;
+                if (funct3 > 2 || (address & (size - 1))) return illegal(commit);
+                uint32_t shift = (address & 3) * 8;
+                uint32_t mask  = (size == 4 ? 0xFFFFFFFFu : ((1u << (size * 8)) - 1)) << shift;
+                // MMIO registers are word-wide and see the lane-shifted data, like the bus
+                uint32_t word  = (size == 4 || (address & 0x40000000)) ? b << shift
+                               : (loadWord(address) & ~mask) | ((b << shift) & mask);
+                storeWord(address, word);
+                commit.memoryWrite   = true;
+                commit.memoryAddress = address;
+                commit.memoryData    = b << shift;
+                write = false;
+                break;
+            }
+            case OP_I_TYPE: {
+                int32_t  imm   = rv32_imm_i(insn);
+                uint32_t shamt = RV_RS2(insn);
+                switch (funct3) {
+                    case 0: value = a + imm; break;
+                    case 2: value = (int32_t)a < imm; break;
+                    case 3: value = a < (uint32_t)imm; break;
+                    case 4: value = a ^ imm; break;
+                    case 6: value = a | imm; break;
+                    case 7: value = a & imm; break;
+                    case 1:
+                        if (funct7 == 0x00) value = a << shamt;
+                        else if (funct7 == 0x30 && shamt == 0) value = clz(a);
+                        else if (funct7 == 0x30 && shamt == 1) value = ctz(a);
+                        else if (funct7 == 0x30 && shamt == 2) value = cpop(a);
+                        else if (funct7 == 0x30 && shamt == 4) value = (uint32_t)(int8_t)a;
+                        else if (funct7 == 0x30 && shamt == 5) value = (uint32_t)(int16_t)a;
+                        else return illegal(commit);
+                        break;
+                    case 5:
+                        if (funct7 == 0x00) value = a >> shamt;
+                        else if (funct7 == 0x20) value = (uint32_t)((int32_t)a >> shamt);
+                        else if (funct7 == 0x30) value = ror(a, shamt);
+                        else if ((insn >> 20) == 0x287) value = orcb(a);
+                        else if ((insn >> 20) == 0x698) value = rev8(a);
+                        else return illegal(commit);
+                        break;
+                }
+                break;
+            }
+            case OP_R_TYPE: {
+                switch (funct7 << 3 | funct3) {
+                    case 0x00 << 3 | 0: value = a + b; break;
+                    case 0x20 << 3 | 0: value = a - b; break;
+                    case 0x00 << 3 | 1: value = a << (b & 31); break;
+                    case 0x00 << 3 | 2: value = (int32_t)a < (int32_t)b; break;
+                    case 0x00 << 3 | 3: value = a < b; break;
+                    case 0x00 << 3 | 4: value = a ^ b; break;
+                    case 0x00 << 3 | 5: value = a >> (b & 31); break;
+                    case 0x20 << 3 | 5: value = (uint32_t)((int32_t)a >> (b & 31)); break;
+                    case 0x00 << 3 | 6: value = a | b; break;
+                    case 0x00 << 3 | 7: value = a & b; break;
+                    case 0x20 << 3 | 4: value = ~(a ^ b); break;                 // XNOR
+                    case 0x20 << 3 | 6: value = a | ~b; break;                   // ORN
+                    case 0x20 << 3 | 7: value = a & ~b; break;                   // ANDN
+                    case 0x05 << 3 | 4: value = (int32_t)a < (int32_t)b ? a : b; break; // MIN
+                    case 0x05 << 3 | 5: value = a < b ? a : b; break;            // MINU
+                    case 0x05 << 3 | 6: value = (int32_t)a < (int32_t)b ? b : a; break; // MAX
+                    case 0x05 << 3 | 7: value = a < b ? b : a; break;            // MAXU
+                    case 0x10 << 3 | 2: value = (a << 1) + b; break;             // SH1ADD
+                    case 0x10 << 3 | 4: value = (a << 2) + b; break;             // SH2ADD
+                    case 0x10 << 3 | 6: value = (a << 3) + b; break;             // SH3ADD
+                    case 0x30 << 3 | 1: value = ror(a, (32 - (b & 31)) & 31); break; // ROL
+                    case 0x30 << 3 | 5: value = ror(a, b & 31); break;           // ROR
+                    case 0x04 << 3 | 4:                                          // ZEXT.H
+                        if (RV_RS2(insn)) return illegal(commit);
+                        value = a & 0xFFFF;
+                        break;
+                    default: return illegal(commit);
+                }
+                break;
+            }
+            case OP_AMO: {
+                uint32_t funct5 = funct7 >> 2;
+                if (funct3 != 2 || (a & 3)) return illegal(commit);
+                commit.memoryAddress = a;
+                if (funct5 == 0x02) {                   // LR.W
+                    value       = loadWord(a);
+                    reservation = a >> 2;
+                    reserved    = true;
+                    commit.memoryRead = true;
+                    break;
+                }
+                if (funct5 == 0x03) {                   // SC.W
+                    bool success = reserved && reservation == (a >> 2);
+                    reserved = false;
+                    if (success) storeWord(a, b);
+                    value = !success;
+                    commit.memoryWrite = true;
+                    commit.memoryData  = b;
+                    break;
+                }
+                uint32_t old = loadWord(a), updated;
+                switch (funct5) {
+                    case 0x00: updated = old + b; break;
+                    case 0x01: updated = b; break;
+                    case 0x04: updated = old ^ b; break;
+                    case 0x08: updated = old | b; break;
+                    case 0x0C: updated = old & b; break;
+                    case 0x10: updated = (int32_t)old < (int32_t)b ? old : b; break;
+                    case 0x14: updated = (int32_t)old < (int32_t)b ? b : old; break;
+                    case 0x18: updated = old < b ? old : b; break;
+                    case 0x1C: updated = old < b ? b : old; break;
+                    default: return illegal(commit);
+                }
+                storeWord(a, updated);
+                value = old;
+                commit.memoryRead  = commit.memoryWrite = true;
+                commit.memoryData  = updated;
+                break;
+            }
+            case 0x0F:                                  // FENCE / FENCE.I: one hart, no caches to sync
+                write = false;
+                break;
+            default:
+                return illegal(commit);
+        }
+
+        if (write && rd) {
+            x[rd] = value;
+            commit.registerWrite = true;
+            commit.registerData  = value;
+        }
+        pc = next;
+        retired++;
+        return commit;
+    }
+
+    // --- MEMORY (as seen from the bus) ---
+    uint32_t loadWord(uint32_t address) {
+        if (address & 0x40000000) return loadMmio(address & ~3u);
+        if (address & 0x20000000) return ram[(address >> 2) & (ram.size() - 1)];
+        return rom[(address >> 2) & (rom.size() - 1)];
+    }
+
+    void storeWord(uint32_t address, uint32_t data) {
+        if (reserved && reservation == (address >> 2)) reserved = false;
+        if (address & 0x40000000) storeMmio(address & ~3u, data);
+        else if (address & 0x20000000) ram[(address >> 2) & (ram.size() - 1)] = data;
+    }
+
+    uint32_t              x[32] = {};
+    uint32_t              pc    = 0;
+    uint64_t              retired = 0;
+    std::vector<uint32_t> rom;
+    std::vector<uint32_t> ram;
+
+private:
+    Commit illegal(Commit commit) {
+        commit.illegal = true;
+        return commit;
+    }
+
+    static uint32_t clz(uint32_t v)  { return v ? __builtin_clz(v) : 32; }
+    static uint32_t ctz(uint32_t v)  { return v ? __builtin_ctz(v) : 32; }
+    static uint32_t cpop(uint32_t v) { return __builtin_popcount(v); }
+    static uint32_t ror(uint32_t v, uint32_t n) { return n ? (v >> n) | (v << (32 - n)) : v; }
+    static uint32_t rev8(uint32_t v) { return __builtin_bswap32(v); }
+    static uint32_t orcb(uint32_t v) {
+        uint32_t out = 0;
+        for (int i = 0; i < 32; i += 8) if ((v >> i) & 0xFF) out |= 0xFFu << i;
+        return out;
+    }
+
+    bool     reserved    = false;
+    uint32_t reservation = 0;   // Reserved word address (address >> 2)
+};
+
+#endif
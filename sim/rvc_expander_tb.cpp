@@ -0,0 +1,169 @@
+#include <iostream>
+#include "Vrvc_expander.h"
+#include "tb_framework.h"
+
+// --- THE GOLDEN MODEL ---
+// Straight from the RVC tables: returns the 32-bit equivalent of halfword 'c',
+// or 0 for reserved / floating-point / RV64-only encodings.
+static uint32_t bits(uint32_t value, int high, int low) { return (value >> low) & ((1u << (high - low + 1)) - 1); }
+static int32_t  sext(uint32_t value, int width)         { return (int32_t)(value << (32 - width)) >> (32 - width); }
+
+static uint32_t enc_i(int32_t imm, int rs1, int f3, int rd, int op) { return ((uint32_t)imm << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | op; }
+static uint32_t enc_s(int32_t imm, int rs2, int rs1) {
+    return (bits(imm, 11, 5) << 25) | (rs2 << 20) | (rs1 << 15) | (2 << 12) | (bits(imm, 4, 0) << 7) | 0x23;
+}
+static uint32_t enc_r(int f7, int rs2, int rs1, int f3, int rd) { return (f7 << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | 0x33; }
+static uint32_t enc_b(int32_t imm, int rs1, int f3) {
+    return (bits(imm, 12, 12) << 31) | (bits(imm, 10, 5) << 25) | (rs1 << 15) | (f3 << 12) | (bits(imm, 4, 1) << 8) | (bits(imm, 11, 11) << 7) | 0x63;
+}
+static uint32_t enc_j(int32_t imm, int rd) {
+    return (bits(imm, 20, 20) << 31) | (bits(imm, 10, 1) << 21) | (bits(imm, 11, 11) << 20) | (bits(imm, 19, 12) << 12) | (rd << 7) | 0x6F;
+}
+
+uint32_t solve_golden(uint32_t c) {
+    int quadrant = c & 3, funct3 = bits(c, 15, 13);
+    int rd = bits(c, 11, 7), rs2 = bits(c, 6, 2);
+    int rdp = 8 + bits(c, 4, 2), rs1p = 8 + bits(c, 9, 7);
+    int32_t ci = sext((bits(c, 12, 12) << 5) | bits(c, 6, 2), 6);
+
+    if (quadrant == 0) {
+        uint32_t uimm = (bits(c, 6, 6) << 2) | (bits(c, 12, 10) << 3) | (bits(c, 5, 5) << 6);
+        if (funct3 == 0) {
+            uint32_t nzuimm = (bits(c, 6, 6) << 2) | (bits(c, 5, 5) << 3) | (bits(c, 12, 11) << 4) | (bits(c, 10, 7) << 6);
+            return nzuimm ? enc_i(nzuimm, 2, 0, rdp, 0x13) : 0;
+        }
+        if (funct3 == 2) return enc_i(uimm, rs1p, 2, rdp, 0x03);
+        if (funct3 == 6) return enc_s(uimm, rdp, rs1p);
+        return 0;
+    }
+
+    if (quadrant == 1) {
+        int32_t jimm = sext((bits(c, 12, 12) << 11) | (bits(c, 8, 8) << 10) | (bits(c, 10, 9) << 8) | (bits(c, 6, 6) << 7) |
+                            (bits(c, 7, 7) << 6) | (bits(c, 2, 2) << 5) | (bits(c, 11, 11) << 4) | (bits(c, 5, 3) << 1), 12);
+        int32_t bimm = sext((bits(c, 12, 12) << 8) | (bits(c, 6, 5) << 6) | (bits(c, 2, 2) << 5) | (bits(c, 11, 10) << 3) |
+                            (bits(c, 4, 3) << 1), 9);
+        switch (funct3) {
+            case 0: return enc_i(ci, rd, 0, rd, 0x13);
+            case 1: return enc_j(jimm, 1);
+            case 2: return enc_i(ci, 0, 0, rd, 0x13);
+            case 3:
+                if (ci == 0) return 0;
+                if (rd == 2) {
+                    int32_t imm = sext((bits(c, 12, 12) << 9) | (bits(c, 4, 3) << 7) | (bits(c, 5, 5) << 6) |
+                                       (bits(c, 2, 2) << 5) | (bits(c, 6, 6) << 4), 10);
+                    return enc_i(imm, 2, 0, 2, 0x13);
+                }
+                return ((uint32_t)ci << 12) | (rd << 7) | 0x37;
+            case 4:
+                switch (bits(c, 11, 10)) {
+                    case 0:  return bits(c, 12, 12) ? 0 : enc_i(rs2, rs1p, 5, rs1p, 0x13);
+                    case 1:  return bits(c, 12, 12) ? 0 : enc_i(0x400 | rs2, rs1p, 5, rs1p, 0x13);
+                    case 2:  return enc_i(ci, rs1p, 7, rs1p, 0x13);
+                    default: {
+                        if (bits(c, 12, 12)) return 0;
+                        const int f3[] = {0, 4, 6, 7};
+                        int op = bits(c, 6, 5);
+                        return enc_r(op == 0 ? 0x20 : 0, rdp, rs1p, f3[op], rs1p);
+                    }
+                }
+            case 5: return enc_j(jimm, 0);
+            case 6: return enc_b(bimm, rs1p, 0);
+            default: return enc_b(bimm, rs1p, 1);
+        }
+    }
+
+    // Quadrant 2
+    switch (funct3) {
+        case 0: return bits(c, 12, 12) ? 0 : enc_i(rs2, rd, 1, rd, 0x13);
+        case 2: {
+            uint32_t uimm = (bits(c, 6, 4) << 2) | (bits(c, 12, 12) << 5) | (bits(c, 3, 2) << 6);
+            return rd ? enc_i(uimm, 2, 2, rd, 0x03) : 0;
+        }
+        case 4:
+            if (!bits(c, 12, 12)) {
+                if (rs2) return enc_r(0, rs2, 0, 0, rd);
+                return rd ? enc_i(0, rd, 0, 0, 0x67) : 0;
+            }
+            if (!rd && !rs2) return 0x00100073;
+            if (!rs2)        return enc_i(0, rd, 0, 1, 0x67);
+            return enc_r(0, rs2, rd, 0, rd);
+        case 6: {
+            uint32_t uimm = (bits(c, 12, 9) << 2) | (bits(c, 8, 7) << 6);
+            return enc_s(uimm, rs2, 2);
+        }
+        default: return 0;
+    }
+}
+
+// Presents halfword 'c' with junk in the upper half (the next instruction)
+void expand(Testbench<Vrvc_expander>& tb, uint32_t c) {
+    tb->fetchWindow = ((tb.random32() & 0xFFFF) << 16) | c;
+    tb.tick();
+}
+
+int main(int argc, char** argv) {
+    Testbench<Vrvc_expander> tb(argc, argv, "RVC Expander");
+    Vrvc_expander* rvc = tb.dut();
+
+    // ==========================================
+    // TEST 1: KNOWN ENCODINGS (ASSEMBLER OUTPUT)
+    // ==========================================
+    struct Vector { uint16_t compressed; uint32_t expanded; const char *text; };
+    const Vector vectors[] = {
+        {0x0001, 0x00000013, "c.nop"},
+        {0x4505, 0x00100513, "c.li a0, 1"},
+        {0x852E, 0x00B00533, "c.mv a0, a1"},
+        {0x952E, 0x00B50533, "c.add a0, a1"},
+        {0x8082, 0x00008067, "c.jr ra (ret)"},
+        {0x1141, 0xFF010113, "c.addi sp, -16"},
+        {0x0808, 0x01010513, "c.addi4spn a0, sp, 16"},
+        {0x40B2, 0x00C12083, "c.lwsp ra, 12(sp)"},
+        {0xC606, 0x00112623, "c.swsp ra, 12(sp)"},
+        {0x4188, 0x0005A503, "c.lw a0, 0(a1)"},
+        {0xC1C8, 0x00A5A223, "c.sw a0, 4(a1)"},
+        {0x6505, 0x00001537, "c.lui a0, 1"},
+        {0xA001, 0x0000006F, "c.j 0"},
+        {0x2001, 0x000000EF, "c.jal 0"},
+        {0xC101, 0x00050063, "c.beqz a0, 0"},
+        {0x9002, 0x00100073, "c.ebreak"},
+    };
+    tb.vectors("Assembler Vectors Expanded Correctly", sizeof(vectors) / sizeof(vectors[0]), [&](uint64_t i) {
+        const Vector &v = vectors[i];
+        expand(tb, v.compressed);
+        if (rvc->isCompressed && rvc->instruction == v.expanded) return true;
+        std::cout << "  " << v.text << ": expected 0x" << std::hex << v.expanded
+                  << " got 0x" << rvc->instruction << "\n";
+        return false;
+    });
+
+    // ==========================================
+    // TEST 2: EXHAUSTIVE 16-BIT SWEEP
+    // ==========================================
+    // Quadrants 0-2 only: (c & 3) == 3 is a 32-bit instruction
+    int illegal = 0;
+    tb.vectors("All Compressed Encodings Matched", 0xC000, [&](uint64_t i) {
+        uint32_t c = ((i >> 14) & 3) | ((i & 0x3FFF) << 2);
+        expand(tb, c);
+        uint32_t expected = solve_golden(c);
+        illegal += rvc->isIllegal;
+        if (rvc->instruction == expected && rvc->isIllegal == (expected == 0)) return true;
+        std::cout << "  Halfword 0x" << std::hex << c << ": expected 0x" << expected
+                  << " got 0x" << rvc->instruction << " (illegal=" << (int)rvc->isIllegal << ")\n";
+        return false;
+    });
+    std::cout << "[INFO] " << std::dec << illegal << " illegal encodings.\n";
+
+    // ==========================================
+    // TEST 3: 32-BIT INSTRUCTIONS PASS THROUGH
+    // ==========================================
+    tb.vectors("32-bit Words Passed Through Unchanged", 100000, [&](uint64_t) {
+        uint32_t word = tb.random32() | 3;
+        rvc->fetchWindow = word;
+        tb.tick();
+        if (!rvc->isCompressed && !rvc->isIllegal && rvc->instruction == word) return true;
+        std::cout << "  32-bit word 0x" << std::hex << word << " was modified.\n";
+        return false;
+    });
+
+    return tb.finish();
+}
@@ -0,0 +1,27 @@
+#ifndef SOC_CONFIG_H
+#define SOC_CONFIG_H
+
+// --- SOC_TOP PARAMETERS SEEN BY THE HARNESS ---
+// Defaults match rtl/soc_top.sv. run.sh turns every -G<NAME>=<value> in
+// VERILATOR_FLAGS into -DSOC_<NAME>=<value>, so the harness follows the
+// parameters the model was built with.
+#ifndef SOC_CLOCK_DIVIDER_BITS
+#define SOC_CLOCK_DIVIDER_BITS 3
+#endif
+#ifndef SOC_UART_CLOCKS_PER_BIT
+#define SOC_UART_CLOCKS_PER_BIT 108
+#endif
+#ifndef SOC_ROM_WORDS
+#define SOC_ROM_WORDS 1024
+#endif
+#ifndef SOC_RAM_WORDS
+#define SOC_RAM_WORDS 1024
+#endif
+
+// The testbench toggles the system clock once per tick, and cpuClock is
+// clockDivider's top bit: 2^(N+1) ticks per CPU cycle (16 by default)
+#define SOC_TICK_SHIFT      (SOC_CLOCK_DIVIDER_BITS + 1)
+#define SOC_TICKS_PER_CYCLE (1L << SOC_TICK_SHIFT)
+#define SOC_CPU_MHZ         (100.0 / (1 << SOC_CLOCK_DIVIDER_BITS)) // From the 100 MHz system clock
+
+#endif
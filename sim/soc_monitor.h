@@ -0,0 +1,67 @@
+#ifndef SOC_MONITOR_H
+#define SOC_MONITOR_H
+
+#include <cstdint>
+#include "svdpi.h"
+#include "Vsoc_top__Dpi.h"
+
+/**
+ * @brief Event sink for the SoC's DPI-C monitor (rtl/soc_top.sv section 6).
+ * The RTL calls in only when something commits: a hart 0 retirement, a CPU
+ * bus write, a trap entry or a timer event. The harness therefore never
+ * polls rootp per cycle and the model needs no public signals on its
+ * datapath. Subclass, set cycle before each eval() and install() once.
+ */
+class SocMonitor {
+public:
+    struct Retire {
+        uint32_t pc;
+        uint32_t instruction;    // After RVC expansion
+        bool     registerWrite;  // rd != x0 written
+        uint32_t registerData;
+        bool     busRead;
+        bool     busWrite;
+        uint32_t busAddress;
+        uint32_t busData;        // Store data
+    };
+
+    virtual ~SocMonitor() { if (active() == this) active() = nullptr; }
+
+    virtual void onRetire(const Retire &retire) { (void)retire; }
+    virtual void onWrite(uint32_t address, uint32_t data) { (void)address; (void)data; }
+    virtual void onTrap(uint32_t pc, uint32_t vector) { (void)pc; (void)vector; }
+    virtual void onTimer(uint32_t pc) { (void)pc; }
+
+    void install() { active() = this; }
+
+    // The callbacks arrive with no context, so one monitor is routed at a time
+    static SocMonitor *&active() {
+        static SocMonitor *monitor = nullptr;
+        return monitor;
+    }
+
+    uint64_t cycle = 0;  // CPU cycle of the edge being evaluated
+};
+
+// --- DPI-C IMPORTS (prototypes in the Verilator-generated Vsoc_top__Dpi.h) ---
+void monitor_retire(int pc, int instruction, svBit registerWrite, int registerData,
+                    svBit busRead, svBit busWrite, int busAddress, int busData) {
+    if (SocMonitor *monitor = SocMonitor::active()) {
+        monitor->onRetire({(uint32_t)pc, (uint32_t)instruction, registerWrite != 0, (uint32_t)registerData,
+                           busRead != 0, busWrite != 0, (uint32_t)busAddress, (uint32_t)busData});
+    }
+}
+
+void monitor_write(int address, int data) {
+    if (SocMonitor *monitor = SocMonitor::active()) monitor->onWrite((uint32_t)address, (uint32_t)data);
+}
+
+void monitor_trap(int pc, int vector) {
+    if (SocMonitor *monitor = SocMonitor::active()) monitor->onTrap((uint32_t)pc, (uint32_t)vector);
+}
+
+void monitor_timer(int pc) {
+    if (SocMonitor *monitor = SocMonitor::active()) monitor->onTimer((uint32_t)pc);
+}
+
+#endif
@@ -0,0 +1,283 @@
+#include "Vsoc_top.h"
+#include "Vsoc_top___024root.h"
+#include "verilated.h"
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "fuzz_program.h"
+#include "host_channel.h"
+#include "memory_backdoor.h"
+#include "rv32_disasm.h"
+#include "rv32_iss.h"
+#include "soc_config.h"
+#include "soc_monitor.h"
+#include "uart_receiver.h"
+
+/**
+ * @brief The ISS plus the SoC's MMIO registers that the fuzz programs use.
+ */
+class SocIss : public Rv32Iss {
+public:
+    SocIss() : Rv32Iss(SOC_ROM_WORDS, SOC_RAM_WORDS) {}
+
+    uint32_t loadMmio(uint32_t address) override {
+        switch (address) {
+            case 0x40000008: return divisor;   // UART divisor
+            case 0x40000014: return 0;         // MHARTID (hart 0)
+            case 0x4000001C: return 1;         // Hart count
+            default:         return 0;
+        }
+    }
+
+    void storeMmio(uint32_t address, uint32_t data) override {
+        if (address == 0x40000008 && (data & 0xFFFF)) divisor = data & 0xFFFF;
+    }
+
+    uint32_t divisor = UART_CLOCKS_PER_BIT;
+};
+
+/**
+ * @brief Compares hart 0's commits with the ISS, one retirement at a time.
+ * Retirements before the program's first instruction belong to the boot
+ * stub's park loop and are only counted. The first difference in PC,
+ * instruction, register write or bus access ends the run with a report.
+ */
+class LockstepMonitor : public SocMonitor {
+public:
+    void onRetire(const Retire &retire) override {
+        if (!iss || (!armed && retire.pc != FUZZ_PROGRAM_BASE)) {
+            if (retire.pc == FUZZ_PARK_PC) parked++;
+            return;
+        }
+        armed = true;
+        if (failed || exited) return;
+
+        Rv32Iss::Commit expected = iss->step();
+        bool same = retire.pc == expected.pc && retire.instruction == expected.instruction && !expected.illegal &&
+                    retire.registerWrite == expected.registerWrite &&
+                    (!retire.registerWrite || retire.registerData == expected.registerData) &&
+                    retire.busRead == expected.memoryRead && retire.busWrite == expected.memoryWrite &&
+                    (!(retire.busRead || retire.busWrite) || retire.busAddress == expected.memoryAddress) &&
+                    (!retire.busWrite || retire.busData == expected.memoryData);
+        if (same) return;
+
+        failed = true;
+        report << "commit #" << iss->retired << " at cycle " << cycle << ", pc 0x" << hex(expected.pc) << "  "
+               << rv32_disasm(expected.instruction, expected.pc) << (expected.illegal ? "  (not in the ISS)" : "") << "\n"
+               << "  rtl: pc 0x" << hex(retire.pc) << " " << hex(retire.instruction)
+               << describe(retire.registerWrite, retire.registerData, retire.busRead, retire.busWrite,
+                           retire.busAddress, retire.busData) << "\n"
+               << "  iss: pc 0x" << hex(expected.pc) << " " << hex(expected.instruction)
+               << describe(expected.registerWrite, expected.registerData, expected.memoryRead, expected.memoryWrite,
+                           expected.memoryAddress, expected.memoryData) << "\n";
+    }
+
+    void onWrite(uint32_t address, uint32_t data) override {
+        (void)data;
+        if (armed && address == HOST_EXIT) exited = true;
+    }
+
+    void onTrap(uint32_t pc, uint32_t vector) override {
+        if (!armed || failed) return;
+        failed = true;
+        report << "unexpected trap at pc 0x" << hex(pc) << " (vector 0x" << hex(vector) << ")\n";
+    }
+
+    static std::string hex(uint32_t value) {
+        std::ostringstream text;
+        text << std::hex << std::setfill('0') << std::setw(8) << value;
+        return text.str();
+    }
+
+    SocIss            *iss    = nullptr;   // Set in the child: the parent only boots and parks
+    uint64_t           parked = 0;
+    bool               armed  = false;
+    bool               failed = false;
+    bool               exited = false;
+    std::ostringstream report;
+
+private:
+    static std::string describe(bool registerWrite, uint32_t registerData, bool read, bool write,
+                                uint32_t address, uint32_t data) {
+        std::string text;
+        if (registerWrite) text += " rd=0x" + hex(registerData);
+        if (read)          text += " R[0x" + hex(address) + "]";
+        if (write)         text += " W[0x" + hex(address) + "]=0x" + hex(data);
+        return text;
+    }
+};
+
+// Shared with the forked children (MAP_SHARED)
+struct FuzzTotals {
+    std::atomic<uint64_t> instructions;
+    std::atomic<uint64_t> cycles;
+};
+
+// One system clock edge; SOC_TICKS_PER_CYCLE (16) per CPU cycle
+static void tick(Vsoc_top *dut, LockstepMonitor &monitor, uint64_t &ticks) {
+    dut->clock ^= 1;
+    if (ticks > 20) dut->resetActiveLow = 1;
+    monitor.cycle = ticks >> SOC_TICK_SHIFT;
+    dut->eval();
+    ticks++;
+}
+
+// Runs in a forked child, on the parked snapshot. Returns the exit status:
+// 0 match, 1 mismatch (commit or final RAM), 2 timeout
+static int runProgram(Vsoc_top *dut, LockstepMonitor &monitor, uint64_t ticks, uint32_t seed, uint32_t sequences,
+                      FuzzTotals *totals) {
+    FuzzProgram program(seed, sequences, SOC_ROM_WORDS - FUZZ_PROGRAM_BASE / 4);
+    SocIss iss;
+
+    // ROM: the parent's image (boot stub, zeros) plus the program
+    for (uint32_t index = 0; index < SOC_ROM_WORDS; index++) iss.rom[index] = backdoor_read_word(dut, 4 * index);
+    for (size_t index = 0; index < program.words.size(); index++) {
+        backdoor_write_word(dut, FUZZ_PROGRAM_BASE + 4 * index, program.words[index]);
+        iss.rom[FUZZ_PROGRAM_BASE / 4 + index] = program.words[index];
+    }
+
+    // RAM: random contents, then release the park loop through the mailbox
+    std::mt19937 random(seed * 0x9E3779B9u + 1);
+    for (uint32_t index = 0; index < SOC_RAM_WORDS; index++) iss.ram[index] = random();
+    iss.ram[(FUZZ_MAILBOX >> 2) & (SOC_RAM_WORDS - 1)] = FUZZ_PROGRAM_BASE;
+    for (uint32_t index = 0; index < SOC_RAM_WORDS; index++) backdoor_write_word(dut, 0x20000000 + 4 * index, iss.ram[index]);
+
+    iss.pc      = FUZZ_PROGRAM_BASE;
+    monitor.iss = &iss;
+
+    // Every instruction commits within a few cycles; forward-only control flow bounds the rest
+    uint64_t start = ticks, limit = ticks + SOC_TICKS_PER_CYCLE * (256 + 8 * program.words.size());
+    while (ticks < limit && !monitor.failed && !monitor.exited) tick(dut, monitor, ticks);
+
+    if (!monitor.failed && monitor.exited) {
+        for (uint32_t index = 0; index < SOC_RAM_WORDS; index++) {
+            uint32_t address = 0x20000000 + 4 * index;
+            uint32_t actual  = backdoor_read_word(dut, address);
+            if (actual == iss.ram[index]) continue;
+            if (!monitor.failed) monitor.report << "final RAM differs:\n";
+            monitor.failed = true;
+            monitor.report << "  [0x" << LockstepMonitor::hex(address) << "] rtl 0x" << LockstepMonitor::hex(actual)
+                           << " iss 0x" << LockstepMonitor::hex(iss.ram[index]) << "\n";
+        }
+    }
+    totals->instructions += iss.retired;
+    totals->cycles       += (ticks - start) >> SOC_TICK_SHIFT;
+
+    if (monitor.failed) {
+        std::cout << "\033[1;31m[FUZZ] seed " << seed << ": " << monitor.report.str() << "\033[0m" << std::flush;
+        return 1;
+    }
+    if (!monitor.exited) {
+        std::cout << "\033[1;31m[FUZZ] seed " << seed << ": no HOST_EXIT after " << iss.retired
+                  << " commits (pc 0x" << LockstepMonitor::hex(iss.pc) << ")\033[0m" << std::endl;
+        return 2;
+    }
+    return 0;
+}
+
+static uint64_t plusarg(const char *name, uint64_t fallback) {
+    std::string arg = Verilated::commandArgsPlusMatch(name);
+    return arg.empty() ? fallback : std::stoull(arg.substr(arg.find('=') + 1));
+}
+
+/**
+ * @brief Differential fuzzer: random programs on Vsoc_top against the ISS.
+ * The parent boots the SoC once into the park loop, then forks one child per
+ * program from that snapshot, so no test case pays for construction, the
+ * $readmemh or reset. Up to +jobs children run at once.
+ *   +seed=<n>         first program seed (program i uses seed + i)
+ *   +fuzz-count=<n>   programs to run (default 1000)
+ *   +fuzz-length=<n>  random sequences per program (default 150)
+ *   +jobs=<n>         concurrent children (default: all cores)
+ * A failing seed is reproduced with +seed=<seed> +fuzz-count=1.
+ */
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+
+    uint32_t seed      = plusarg("seed=", 1);
+    uint64_t count     = plusarg("fuzz-count=", 1000);
+    uint32_t sequences = plusarg("fuzz-length=", 150);
+    uint32_t jobs      = plusarg("jobs=", std::max(1u, std::thread::hardware_concurrency()));
+
+    Vsoc_top *dut = new Vsoc_top;
+    LockstepMonitor monitor;
+    monitor.install();
+
+    // --- 1. BOOT TO THE PARK LOOP (the snapshot) ---
+    dut->clock = 0;
+    dut->resetActiveLow = 0;
+    dut->eval();   // Initial blocks ($readmemh) run here; the fuzz image replaces theirs
+    std::vector<uint32_t> stub = FuzzProgram::bootStub();
+    for (uint32_t index = 0; index < SOC_ROM_WORDS; index++) {
+        backdoor_write_word(dut, 4 * index, index < stub.size() ? stub[index] : 0);
+        backdoor_write_word(dut, 0x20000000 + 4 * index, 0);
+    }
+
+    uint64_t ticks = 0;
+    while (monitor.parked < 2 && ticks < SOC_TICKS_PER_CYCLE * 1000) tick(dut, monitor, ticks);
+    if (monitor.parked < 2) {
+        std::cout << "\033[1;31m[FUZZ] Boot stub never reached the park loop (ICACHE_ENABLE=0 builds only)\033[0m" << std::endl;
+        return 2;
+    }
+    std::cout << "[FUZZ] Parked after " << (ticks >> SOC_TICK_SHIFT) << " CPU cycles; forking " << count << " programs from this snapshot on "
+              << jobs << " jobs" << std::endl;
+
+    // --- 2. FORK SERVER ---
+    FuzzTotals *totals = (FuzzTotals *)mmap(nullptr, sizeof(FuzzTotals), PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    new (totals) FuzzTotals{};
+
+    std::map<pid_t, uint32_t> running;   // Child -> program seed
+    std::vector<uint32_t>     failedSeeds;
+    auto reap = [&]() {
+        int status = 0;
+        pid_t pid = wait(&status);
+        if (pid < 0) return;
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) failedSeeds.push_back(running[pid]);
+        running.erase(pid);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t launched = 0;
+    for (; launched < count; launched++) {
+        while (running.size() >= jobs) reap();
+        uint32_t programSeed = seed + (uint32_t)launched;
+        std::cout << std::flush;
+        pid_t pid = fork();
+        if (pid == 0) _exit(runProgram(dut, monitor, ticks, programSeed, sequences, totals));
+        if (pid < 0) {
+            perror("[FUZZ] fork");
+            break;
+        }
+        running[pid] = programSeed;
+    }
+    while (!running.empty()) reap();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // --- 3. SUMMARY ---
+    std::cout << "---------------------------------------------" << std::endl;
+    std::cout << "[FUZZ] " << launched << " programs, " << totals->instructions.load() << " instructions, "
+              << totals->cycles.load() << " CPU cycles in " << std::fixed << std::setprecision(1) << seconds << " s ("
+              << std::setprecision(0) << (seconds > 0 ? launched * 60 / seconds : 0) << " programs/min)" << std::endl;
+    if (failedSeeds.empty()) {
+        std::cout << "\033[1;32m[FUZZ] RTL matched the ISS on every program.\033[0m" << std::endl;
+    } else {
+        std::cout << "\033[1;31m[FUZZ] " << failedSeeds.size() << " programs diverged; reproduce with +seed=<n> +fuzz-count=1:";
+        for (size_t i = 0; i < failedSeeds.size() && i < 16; i++) std::cout << " " << failedSeeds[i];
+        std::cout << "\033[0m" << std::endl;
+    }
+
+    dut->final();
+    delete dut;
+    return failedSeeds.empty() ? 0 : 1;
+}
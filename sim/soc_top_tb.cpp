@@ -2,8 +2,79 @@
 #include "Vsoc_top___024root.h" 
 #include "verilated.h"
 #include "verilated_vcd_c.h"
+#include <chrono>
 #include <iostream>
 #include <iomanip>
+#include "bus_monitor.h"
+#include "flight_recorder.h"
+#include "host_channel.h"
+#include "kernel_stats.h"
+#include "kernel_trace.h"
+#include "latency_monitor.h"
+#include "pc_profiler.h"
+#include "soc_config.h"
+#include "soc_monitor.h"
+#include "symbol_table.h"
+#include "uart_receiver.h"
+
+/**
+ * @brief Routes the SoC's DPI-C events to the harness monitors.
+ * UART and host channel output come from bus writes (UART bytes are also
+ * queued for the serial-line receiver to check), the kernel trace ring
+ * is drained when the firmware completes an entry, and every commit feeds
+ * the latency monitor, the profiler and the flight recorder.
+ */
+class HarnessMonitor : public SocMonitor {
+public:
+    HarnessMonitor(HostChannel &host, UartReceiver &uart, LatencyMonitor &latency, PcProfiler *profiler,
+                   FlightRecorder &flight)
+        : host(host), uart(uart), latency(latency), profiler(profiler), flight(flight) {}
+
+    void onRetire(const Retire &retire) override {
+        latency.onRetire(cycle, retire.pc, retire.instruction);
+        if (profiler) profiler->onRetire(retire.pc, retire.instruction);
+        if (!flight.onRetire(cycle, retire.pc, retire.instruction, retire.registerWrite, retire.registerData,
+                             retire.busRead, retire.busWrite, retire.busAddress, retire.busData)) {
+            stopped = true;
+        }
+    }
+
+    void onTrap(uint32_t pc, uint32_t vector) override {
+        if (!flight.onTrap(cycle, pc, vector)) stopped = true;
+    }
+
+    void onWrite(uint32_t address, uint32_t data) override {
+        if (address == 0x40000000) {
+            std::cout << (char)data << std::flush;
+            uart.expect((uint8_t)data);
+        } else if (address == 0x40000008) {
+            uart.setDivisor(data);
+        } else if ((address >> 28) == 0x4) {
+            host.onMmioWrite(address, data);
+        } else if (address >= TRACE_BASE + 8 && address < TRACE_BASE + 8 + TRACE_CAPACITY * 8 && (address & 7) == 4) {
+            tracePending = true; // Second word of a ring entry: the event is complete
+        }
+    }
+
+    // Monitors the rising edge of the Timer-Interrupt Service Request
+    void onTimer(uint32_t pc) override {
+        latency.onTimerEvent(cycle);
+        std::cout << "\n\033[1;33m[IRQ] Timer Trap at Cycle: "
+                  << std::dec << std::setw(6) << cycle
+                  << " | Vector PC: 0x" << std::hex << std::setw(8) << std::setfill('0') << pc
+                  << std::setfill(' ') << "\033[0m" << std::endl;
+    }
+
+    bool stopped      = false;  // The flight recorder saw a divergence
+    bool tracePending = false;  // The kernel trace ring has a new entry
+
+private:
+    HostChannel    &host;
+    UartReceiver   &uart;
+    LatencyMonitor &latency;
+    PcProfiler     *profiler;
+    FlightRecorder &flight;
+};
 
 /**
  * @brief RISC-V SoC Verification Environment
@@ -16,69 +87,154 @@ int main(int argc, char **argv) {
     Vsoc_top *dut = new Vsoc_top;
     VerilatedVcdC *m_trace = new VerilatedVcdC;
     
-    // Waveform configuration
-    dut->trace(m_trace, 5);
-    m_trace->open("simulation_trace.vcd");
+    // Waveform configuration; +notrace skips the VCD (sweeps, speed measurements)
+    bool traceEnabled = std::string(Verilated::commandArgsPlusMatch("notrace")).empty();
+    if (traceEnabled) {
+        dut->trace(m_trace, 5);
+        m_trace->open("simulation_trace.vcd");
+    }
 
     // Initial hardware state
     dut->clock = 0;
     dut->resetActiveLow = 0;
 
     std::cout << "\033[1;32m[SYS] Initializing RV32I SoC Simulation...\033[0m" << std::endl;
-    std::cout << "[SYS] Monitoring UART MMIO (0x40000000)" << std::endl;
+    std::cout << "[SYS] Monitoring UART MMIO (0x40000000) and Host Region (0x40000100)" << std::endl;
     std::cout << "---------------------------------------------" << std::endl;
 
     // Simulation timing: Scaled for 12.5 MHz CPU frequency
-    const long int MAX_SIM_TICKS = 1000000; 
+    // (SOC_TICKS_PER_CYCLE system clock ticks per CPU cycle, 16 by default);
+    // 62500 CPU cycles unless +max-cycles=<n> asks for more
+    long int MAX_SIM_TICKS = SOC_TICKS_PER_CYCLE * 62500;
+    std::string maxCycles = Verilated::commandArgsPlusMatch("max-cycles=");
+    if (!maxCycles.empty()) MAX_SIM_TICKS = SOC_TICKS_PER_CYCLE * std::stol(maxCycles.substr(maxCycles.find('=') + 1));
+
+    long int cpuCycle = 0;
+
+    HostChannel host(dut);
+    KernelTrace kernelTrace(dut);
 
-    // Edge detection registers
-    bool lastWriteValid = false; 
-    bool lastTimerIrq   = false;
+    // Decodes the uartTransmit pin and checks it against the bytes written on the bus
+    UartReceiver uart(UART_CLOCKS_PER_BIT);
 
+    // Firmware symbols (written by run.sh) drive the latency boundaries
+    SymbolTable symbols;
+    if (!symbols.load()) {
+        std::cout << "[SYS] firmware/firmware.sym not found; using default trap vector only" << std::endl;
+    }
+    LatencyMonitor latency(symbols);
+
+    // +profile prints a flat profile; +profile-folded=<file> writes folded stacks
+    std::string foldedPath = Verilated::commandArgsPlusMatch("profile-folded=");
+    if (!foldedPath.empty()) foldedPath = foldedPath.substr(foldedPath.find('=') + 1);
+    // commandArgsPlusMatch() is a prefix match that returns the first hit
+    // (+profile-folded= would pass), so +profile is compared whole
+    bool profileEnabled = false;
+    for (int i = 1; i < argc; i++) profileEnabled |= std::string(argv[i]) == "+profile";
+    PcProfiler profiler(symbols, !foldedPath.empty());
+
+    // +bus-report=<cycles> prints bus bandwidth per interval
+    std::string busReport = Verilated::commandArgsPlusMatch("bus-report=");
+    BusMonitor busMonitor(dut, busReport.empty() ? 0 : std::stoul(busReport.substr(busReport.find('=') + 1)));
+
+    // Flight recorder: +flight=<n> commits kept (default 64), +hang-cycles=<n>
+    // without PC progress counts as a hang (default 200000, 0 disables)
+    std::string flightSize = Verilated::commandArgsPlusMatch("flight=");
+    std::string hangLimit  = Verilated::commandArgsPlusMatch("hang-cycles=");
+    FlightRecorder flight(symbols,
+                          flightSize.empty() ? 64 : std::stoul(flightSize.substr(flightSize.find('=') + 1)),
+                          hangLimit.empty() ? 200000 : std::stoul(hangLimit.substr(hangLimit.find('=') + 1)));
+    bool flightStopped = false;
+
+    // The RTL reports events through DPI-C as they commit; nothing is polled per cycle
+    HarnessMonitor monitor(host, uart, latency, (profileEnabled || !foldedPath.empty()) ? &profiler : nullptr, flight);
+    monitor.install();
+
+    auto wallStart = std::chrono::steady_clock::now();
     for (long int tick = 0; tick < MAX_SIM_TICKS; tick++) {
         dut->clock ^= 1; // System clock toggle
         
         // Asynchronous reset release
         if (tick > 20) dut->resetActiveLow = 1;
 
+        // SOC_TICKS_PER_CYCLE system ticks per CPU cycle (clockDivider's top bit in soc_top)
+        cpuCycle      = tick >> SOC_TICK_SHIFT;
+        monitor.cycle = cpuCycle;
+
         dut->eval();
-        m_trace->dump((vluint64_t)tick);
-
-        // Synchronous logic monitoring (Rising Edge)
-        if (dut->clock == 1) {
-             
-             // --- 1. MMIO BUS MONITOR (UART Output) ---
-             // Detects valid write cycles to the UART Transmit Buffer
-             bool currentWriteValid = dut->rootp->soc_top__DOT__ioWriteValid;
-             if (currentWriteValid && !lastWriteValid && 
-                 dut->rootp->soc_top__DOT__ioWriteAddress == 0x40000000) {
-                 char dataOut = (char)dut->rootp->soc_top__DOT__ioWriteData;
-                 std::cout << dataOut << std::flush; 
-             }
-             lastWriteValid = currentWriteValid;
-
-             // --- 2. HARDWARE INTERRUPT TRACKER ---
-             // Monitors the rising edge of the Timer-Interrupt Service Request
-             bool currentTimerIrq = dut->rootp->soc_top__DOT__timerInterrupt;
-             if (currentTimerIrq && !lastTimerIrq) {
-                uint32_t trapPC = dut->rootp->soc_top__DOT__programCounter;
-                
-                // Effective Cycle Calculation: Tick / (2 * ClockDivider)
-                long int cpuCycle = tick / 16; 
-
-                std::cout << "\n\033[1;33m[IRQ] Timer Trap at Cycle: " 
-                          << std::dec << std::setw(6) << cpuCycle 
-                          << " | Vector PC: 0x" << std::hex << std::setw(8) << std::setfill('0') << trapPC 
-                          << "\033[0m" << std::endl; 
-             }
-             lastTimerIrq = currentTimerIrq;
+        if (traceEnabled) m_trace->dump((vluint64_t)tick);
+
+        // --- 1. KERNEL TRACE RING ---
+        // Read after eval so the store that completed the entry has landed
+        if (monitor.tracePending) {
+            monitor.tracePending = false;
+            kernelTrace.poll();
+        }
+
+        // --- 2. FLIGHT RECORDER (divergence, hang) ---
+        bool cycleStart = (tick & (SOC_TICKS_PER_CYCLE - 1)) == 0;
+        if (monitor.stopped || (cycleStart && tick > 20 && !flight.check(cpuCycle))) {
+            flightStopped = true;
+            break;
+        }
+        if (cycleStart) {
+            busMonitor.onCycle(cpuCycle);
+            uart.sample(cpuCycle, dut->uartTransmit);
         }
+
+        // --- 3. FIRMWARE EXIT REQUEST ---
+        if (host.exitRequested) break;
     }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
 
     std::cout << "\n---------------------------------------------" << std::endl;
-    std::cout << "\033[1;32m[SYS] Simulation Terminated Successfully.\033[0m" << std::endl;
+    if (host.assertionFailed()) {
+        flight.dump(cpuCycle, "firmware assertion failed at line " + std::to_string(host.assertionLine()));
+    } else if (host.exitRequested && host.exitCode != 0) {
+        flight.dump(cpuCycle, "firmware exited with status " + std::to_string(host.exitCode));
+    }
+    if (flightStopped) {
+        std::cout << "\033[1;31m[SYS] Simulation stopped by the flight recorder after " << std::dec
+                  << cpuCycle << " CPU cycles.\033[0m" << std::endl;
+    } else if (host.exitRequested) {
+        std::cout << (host.exitCode == 0 ? "\033[1;32m" : "\033[1;31m")
+                  << "[SYS] Firmware exited with status " << std::dec << host.exitCode
+                  << " after " << cpuCycle << " CPU cycles.\033[0m" << std::endl;
+    } else {
+        std::cout << "\033[1;32m[SYS] Simulation Terminated Successfully.\033[0m" << std::endl;
+    }
+
+    // --- INSTRUCTION CACHE SUMMARY (ICACHE_ENABLE builds only) ---
+    // The hit counter counts every fetch the cache delivers (a missed fetch
+    // is delivered by the hit after its refill), the miss counter counts line
+    // refills; the two are reported side by side rather than as one ratio
+    uint32_t icacheFetches = dut->rootp->soc_top__DOT__icacheHits;
+    uint32_t icacheFills   = dut->rootp->soc_top__DOT__icacheMisses;
+    if (icacheFetches + icacheFills) {
+        std::cout << std::dec << "[ICACHE] fetches=" << icacheFetches << " line-fills=" << icacheFills
+                  << " fills-per-1k-fetches=" << std::fixed << std::setprecision(2)
+                  << (icacheFetches ? 1000.0 * icacheFills / icacheFetches : 0.0)
+                  << " fetch-stall-cycles=" << dut->rootp->soc_top__DOT__icacheStalls << std::endl;
+    }
+
+    latency.printReport();
+
+    // One machine-readable line per run (sweep.sh builds its table from it)
+    std::cout << std::dec << std::fixed << "[PERF] cycles=" << cpuCycle
+              << " preemptions=" << latency.preemptions() << " switch-cycles=" << latency.preemptionCycles()
+              << " overhead=" << std::setprecision(2) << (cpuCycle ? 100.0 * latency.preemptionCycles() / cpuCycle : 0.0) << "%"
+              << " speed=" << std::setprecision(1) << (wallSeconds > 0 ? cpuCycle / wallSeconds / 1000.0 : 0.0) << "kHz"
+              << " exit=" << (host.exitRequested ? host.exitCode : 0) << std::endl;
+    if (profileEnabled) profiler.printFlatProfile();
+    profiler.writeFoldedStacks(foldedPath);
+    uart.printReport();
+    kernelTrace.printSummary();
+    KernelStats(dut, symbols).printReport();
+    kernelTrace.writeChromeTrace("kernel_trace.json");
 
-    m_trace->close();
+    if (traceEnabled) m_trace->close();
     delete dut;
-    return 0;
+    if (flightStopped) return 3;
+    if (!uart.clean()) return 4;
+    return host.exitRequested ? host.exitCode : 0;
 }
\ No newline at end of file
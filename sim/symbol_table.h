@@ -0,0 +1,74 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Firmware symbol table loaded from `nm --numeric-sort` output.
+ * run.sh saves the listing to firmware/firmware.sym on every build, so the
+ * harness needs no ELF parser and works the same on Linux and macOS.
+ */
+class SymbolTable {
+public:
+    struct Symbol {
+        uint32_t    address;
+        char        type;
+        std::string name;
+    };
+
+    bool load(const std::string &path = "firmware/firmware.sym") {
+        std::ifstream in(path);
+        if (!in) return false;
+
+        std::string line;
+        while (std::getline(in, line)) {
+            std::istringstream fields(line);
+            std::string address, type, name;
+            if (!(fields >> address >> type >> name)) continue;
+            Symbol symbol{(uint32_t)std::stoul(address, nullptr, 16), type[0], name};
+            byName[name] = symbol.address;
+            // Code symbols only: .text (T/t) in the ROM window
+            if ((symbol.type == 'T' || symbol.type == 't') && symbol.address < 0x20000000) {
+                code.push_back(symbol);
+            }
+        }
+        std::sort(code.begin(), code.end(),
+                  [](const Symbol &a, const Symbol &b) { return a.address < b.address; });
+        return !byName.empty();
+    }
+
+    bool empty() const { return byName.empty(); }
+
+    // Address of a named symbol, or 'fallback' if it is not in the table
+    uint32_t address(const std::string &name, uint32_t fallback = 0xFFFFFFFF) const {
+        auto it = byName.find(name);
+        return (it == byName.end()) ? fallback : it->second;
+    }
+
+    // Enclosing code symbol for 'pc', or nullptr if it precedes all symbols
+    const Symbol *function(uint32_t pc) const {
+        auto it = std::upper_bound(code.begin(), code.end(), pc,
+                                   [](uint32_t value, const Symbol &s) { return value < s.address; });
+        if (it == code.begin()) return nullptr;
+        return &*(it - 1);
+    }
+
+    std::string functionName(uint32_t pc) const {
+        const Symbol *symbol = function(pc);
+        return symbol ? symbol->name : "??";
+    }
+
+    const std::vector<Symbol> &codeSymbols() const { return code; }
+
+private:
+    std::map<std::string, uint32_t> byName;
+    std::vector<Symbol>             code;
+};
+
+#endif
@@ -0,0 +1,271 @@
+#ifndef TB_FRAMEWORK_H
+#define TB_FRAMEWORK_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <verilated.h>
+
+// --- PORT DETECTION ---
+// Verilator models expose ports as members (references in Verilator 5, so
+// no member pointers): detect the clock and reset ports by name.
+template <typename T, typename = void> struct tb_has_clock : std::false_type {};
+template <typename T> struct tb_has_clock<T, std::void_t<decltype(std::declval<T &>().clock)>> : std::true_type {};
+template <typename T, typename = void> struct tb_has_system_clock : std::false_type {};
+template <typename T> struct tb_has_system_clock<T, std::void_t<decltype(std::declval<T &>().systemClock)>> : std::true_type {};
+template <typename T, typename = void> struct tb_has_reset : std::false_type {};
+template <typename T> struct tb_has_reset<T, std::void_t<decltype(std::declval<T &>().resetActiveLow)>> : std::true_type {};
+
+static inline std::string tb_hex(uint64_t value) {
+    std::ostringstream text;
+    text << "0x" << std::hex << value;
+    return text.str();
+}
+
+/**
+ * @brief Header-only harness shared by the unit benches in sim/.
+ * Testbench<Vmodule> owns the model and drives its clock ('clock' or
+ * 'systemClock') and active-low reset. Blocks without those ports compile
+ * the clock and reset code away. Every check and vector loop is recorded
+ * as a Result. A vector loop takes its stimulus/check body as a template
+ * argument, so the body inlines into the loop. It is timed and reports
+ * vectors per second, which keeps large randomised sweeps cheap to write
+ * and fast to run. parallelVectors() spreads a sweep over worker threads,
+ * each with its own model, for exhaustive runs over pure decode logic.
+ *   +seed=<n>          reseed random32() and randomAt() (printed on failure)
+ *   +threads=<n>       worker threads for parallelVectors() (default: all cores)
+ *   +tb-results=<file> append the results as JSON lines
+ */
+template <typename Dut>
+class Testbench {
+public:
+    struct Result {
+        std::string name;
+        bool        passed;
+        uint64_t    vectors;   // 1 for a single check
+        double      seconds;   // Wall time of a vector loop, 0 for a single check
+        std::string detail;    // Failure description
+    };
+
+    static constexpr bool hasClock = tb_has_clock<Dut>::value || tb_has_system_clock<Dut>::value;
+    static constexpr bool hasReset = tb_has_reset<Dut>::value;
+
+    Testbench(int argc, char **argv, std::string title) : title(std::move(title)) {
+        Verilated::commandArgs(argc, argv);
+        model = std::make_unique<Dut>();
+
+        std::string seedArg = Verilated::commandArgsPlusMatch("seed=");
+        if (!seedArg.empty()) seed = std::stoul(seedArg.substr(seedArg.find('=') + 1));
+        generator.seed(seed);
+        std::string resultsArg = Verilated::commandArgsPlusMatch("tb-results=");
+        if (!resultsArg.empty()) resultsPath = resultsArg.substr(resultsArg.find('=') + 1);
+        std::string threadsArg = Verilated::commandArgsPlusMatch("threads=");
+        if (!threadsArg.empty()) threads = std::stoul(threadsArg.substr(threadsArg.find('=') + 1));
+        if (!threads) threads = std::max(1u, std::thread::hardware_concurrency());
+
+        std::cout << "[TEST] Starting " << this->title << " Verification...\n";
+    }
+
+    Dut *dut() { return model.get(); }
+    Dut *operator->() { return model.get(); }
+
+    // --- CLOCK & RESET ---
+    // One rising edge per cycle; a combinational block just re-evaluates
+    void tick(uint64_t count = 1) {
+        for (uint64_t i = 0; i < count; i++) {
+            if constexpr (hasClock) {
+                setClock(0); model->eval();
+                setClock(1); model->eval();
+                cycles++;
+            } else {
+                model->eval();
+            }
+        }
+    }
+
+    // Holds resetActiveLow low across 'count' rising edges, then releases it
+    void reset(uint64_t count = 1) {
+        static_assert(hasReset, "reset() needs a resetActiveLow port");
+        model->resetActiveLow = 0;
+        tick(count);
+        model->resetActiveLow = 1;
+        model->eval();
+    }
+
+    uint64_t cycle() const { return cycles; }
+
+    // --- CHECKS ---
+    bool check(bool passed, const std::string &name, const std::string &detail = "") {
+        record({name, passed, 1, 0.0, passed ? "" : detail});
+        std::cout << std::dec;
+        if (passed) std::cout << "[PASS] " << name << "\n";
+        else        std::cout << "[FAIL] " << name << (detail.empty() ? "" : ": " + detail) << "\n";
+        return passed;
+    }
+
+    // Runs body(index) for index = 0..count-1 and stops at the first false.
+    // The body drives the model and compares; it may print its own mismatch detail.
+    template <typename Body>
+    bool vectors(const std::string &name, uint64_t count, Body &&body) {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t index = 0;
+        for (; index < count; index++) {
+            if (!body(index)) break;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        bool passed = (index == count);
+        std::string detail = passed ? "" : "vector #" + std::to_string(index) + " (+seed=" + std::to_string(seed) + ")";
+        record({name, passed, passed ? count : index, seconds, detail});
+        std::cout << std::dec;
+        if (passed) {
+            std::cout << "[PASS] " << name << ": " << count << " vectors";
+            if (seconds > 0) std::cout << " (" << std::fixed << std::setprecision(2) << count / seconds / 1e6 << " M/s)";
+            std::cout << std::defaultfloat << "\n";
+        } else {
+            std::cout << "[FAIL] " << name << ": " << detail << "\n";
+        }
+        return passed;
+    }
+
+    // Runs body(model, index, detail) for index = 0..count-1 on +threads
+    // workers. Each worker owns a model in its own VerilatedContext, so the
+    // body may touch only that model and must derive its stimulus from the
+    // index (randomAt()). Every vector runs: mismatches are counted and the
+    // detail the body wrote for the lowest failing index is reported.
+    template <typename Body>
+    bool parallelVectors(const std::string &name, uint64_t count, Body &&body) {
+        std::atomic<uint64_t> next{0}, mismatches{0};
+        std::mutex  firstLock;
+        uint64_t    firstIndex = count;
+        std::string firstDetail;
+
+        auto worker = [&]() {
+            VerilatedContext context;
+            Dut model(&context);
+            std::string detail;
+            for (uint64_t begin; (begin = next.fetch_add(PARALLEL_BLOCK)) < count;) {
+                uint64_t end = std::min(count, begin + PARALLEL_BLOCK);
+                for (uint64_t index = begin; index < end; index++) {
+                    if (body(model, index, detail)) continue;
+                    mismatches++;
+                    std::lock_guard<std::mutex> guard(firstLock);
+                    if (index < firstIndex) {
+                        firstIndex  = index;
+                        firstDetail = detail;
+                    }
+                    detail.clear();
+                }
+            }
+            model.final();
+        };
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> pool;
+        for (uint32_t i = 1; i < threads; i++) pool.emplace_back(worker);
+        worker();
+        for (std::thread &thread : pool) thread.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        bool passed = !mismatches;
+        std::string detail = passed ? "" : std::to_string(mismatches) + " mismatches, first at vector #" +
+                                           std::to_string(firstIndex) + " (+seed=" + std::to_string(seed) + ")" +
+                                           (firstDetail.empty() ? "" : ": " + firstDetail);
+        record({name, passed, count, seconds, detail});
+        std::cout << std::dec;
+        if (passed) {
+            std::cout << "[PASS] " << name << ": " << count << " vectors on " << threads << " threads";
+            if (seconds > 0) std::cout << " (" << std::fixed << std::setprecision(2) << count / seconds / 1e6 << " M/s)";
+            std::cout << std::defaultfloat << "\n";
+        } else {
+            std::cout << "[FAIL] " << name << ": " << detail << "\n";
+        }
+        return passed;
+    }
+
+    // --- STIMULUS ---
+    uint32_t random32() { return generator(); }
+    uint32_t random(uint32_t bound) { return generator() % bound; }
+
+    // Stateless stream for parallel sweeps: the same (seed, index) always
+    // gives the same word, whichever thread asks (splitmix64)
+    uint32_t randomAt(uint64_t index) const {
+        uint64_t z = ((uint64_t)seed << 40) + (index + 1) * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return (uint32_t)((z ^ (z >> 31)) >> 32);
+    }
+
+    // --- RESULTS ---
+    const std::vector<Result> &results() const { return log; }
+    bool passed() const { return !failures; }
+
+    // Prints the summary, writes +tb-results and returns the process exit status
+    int finish() {
+        std::cout << std::dec << "------------------------------------------\n";
+        if (failures) {
+            std::cout << "[FAILURE] " << title << ": " << failures << " of " << log.size() << " checks failed.\n";
+        } else {
+            std::cout << "[SUCCESS] " << title << " Verified.\n";
+        }
+        if (!resultsPath.empty()) writeResults();
+        model->final();
+        return failures ? 1 : 0;
+    }
+
+private:
+    static const uint64_t PARALLEL_BLOCK = 4096;  // Vectors claimed per worker visit
+
+    void setClock(uint8_t level) {
+        if constexpr (tb_has_clock<Dut>::value) model->clock = level;
+        else                                    model->systemClock = level;
+    }
+
+    void record(Result result) {
+        if (!result.passed) failures++;
+        log.push_back(std::move(result));
+    }
+
+    static std::string quoted(const std::string &text) {
+        std::string out = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out + "\"";
+    }
+
+    void writeResults() const {
+        std::ofstream out(resultsPath, std::ios::app);
+        for (const Result &result : log) {
+            out << "{\"bench\":" << quoted(title) << ",\"check\":" << quoted(result.name)
+                << ",\"passed\":" << (result.passed ? "true" : "false") << ",\"vectors\":" << result.vectors
+                << ",\"seconds\":" << result.seconds << ",\"detail\":" << quoted(result.detail) << "}\n";
+        }
+    }
+
+    std::unique_ptr<Dut> model;
+    std::string          title;
+    std::string          resultsPath;
+    std::vector<Result>  log;
+    uint64_t             failures = 0;
+    uint64_t             cycles   = 0;
+    uint32_t             seed     = 1;
+    uint32_t             threads  = 0;
+    std::mt19937         generator;
+};
+
+#endif
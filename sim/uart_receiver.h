@@ -0,0 +1,116 @@
+#ifndef UART_RECEIVER_H
+#define UART_RECEIVER_H
+
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "soc_config.h"
+
+#define UART_CLOCKS_PER_BIT SOC_UART_CLOCKS_PER_BIT   // soc_top's uart_tx reset divisor (108: 115200 baud at 12.5 MHz)
+
+/**
+ * @brief Bit-accurate 8N1 receiver on soc_top's uartTransmit pin.
+ * It samples every bit in its middle, checks the start and stop bits,
+ * and compares each decoded byte with the stream the CPU wrote to the
+ * UART data register. A frame or ordering bug in uart_tx therefore shows
+ * up even though the console output itself is printed from the bus. On an
+ * idle line a call is one compare. Inside a frame it returns early
+ * between sample points, so leaving it on costs nothing on long runs.
+ */
+class UartReceiver {
+public:
+    explicit UartReceiver(uint32_t clocksPerBit) : programmedDivisor(clocksPerBit) {}
+
+    // Bus side: a byte written to the data register (0x40000000)
+    void expect(uint8_t byte) { expected.push_back(byte); }
+
+    // Bus side: a divisor write (0x40000008); like uart_tx, it takes effect at the next start bit
+    void setDivisor(uint32_t clocksPerBit) {
+        if (clocksPerBit & 0xFFFF) programmedDivisor = clocksPerBit & 0xFFFF;
+    }
+
+    // Line side: call once per CPU cycle with the pin level
+    void sample(uint64_t cycle, bool level) {
+        if (bit < 0) {
+            if (level) return;            // Idle: wait for the start bit's falling edge
+            frameDivisor = programmedDivisor;
+            nextSample   = cycle + frameDivisor / 2;   // This cycle itself at one clock per bit
+            bit          = 0;
+        }
+        if (cycle < nextSample) return;
+        nextSample += frameDivisor;
+
+        if (bit == 0) {
+            if (level) {                  // Start bit did not hold: a glitch, not a frame
+                glitches++;
+                bit = -1;
+                return;
+            }
+        } else if (bit <= 8) {
+            shift = (shift >> 1) | (level ? 0x80 : 0);
+        } else {
+            if (!level) {
+                framingErrors++;
+                report(cycle, "framing error (stop bit low), data 0x", shift);
+            }
+            deliver(cycle, shift);
+            bit = -1;                     // Back to idle at mid-stop; the next falling edge starts a frame
+            return;
+        }
+        bit++;
+    }
+
+    void printReport() const {
+        if (!received && expected.empty()) return;
+        std::cout << "[UART] " << std::dec << received << " bytes decoded from the serial line: "
+                  << mismatches << " mismatches against the bus, " << framingErrors << " framing errors";
+        if (glitches) std::cout << ", " << glitches << " false start bits";
+        if (!expected.empty()) std::cout << ", " << expected.size() << " still in flight";
+        std::cout << std::endl;
+    }
+
+    bool clean() const { return !mismatches && !framingErrors && !glitches; }
+
+private:
+    void deliver(uint64_t cycle, uint8_t byte) {
+        received++;
+        if (expected.empty()) {
+            mismatches++;
+            report(cycle, "byte on the line with no bus write: 0x", byte);
+            return;
+        }
+        if (expected.front() != byte) {
+            mismatches++;
+            report(cycle, "line 0x" + hex(byte) + " != bus 0x", expected.front());
+        }
+        expected.pop_front();
+    }
+
+    void report(uint64_t cycle, const std::string &what, uint8_t byte) {
+        if (reports++ >= MAX_REPORTS) return;
+        std::cout << "\n\033[1;31m[UART] cycle " << std::dec << cycle << ": " << what << hex(byte) << "\033[0m" << std::endl;
+    }
+
+    static std::string hex(uint8_t byte) {
+        static const char digits[] = "0123456789abcdef";
+        return {digits[byte >> 4], digits[byte & 0xF]};
+    }
+
+    static const uint32_t MAX_REPORTS = 8;
+
+    std::deque<uint8_t> expected;
+    uint32_t programmedDivisor;
+    uint32_t frameDivisor  = 0;
+    uint64_t nextSample    = 0;
+    int      bit           = -1;   // -1 idle, 0 start, 1..8 data (LSB first), 9 stop
+    uint8_t  shift         = 0;
+    uint64_t received      = 0;
+    uint64_t mismatches    = 0;
+    uint64_t framingErrors = 0;
+    uint64_t glitches      = 0;
+    uint32_t reports       = 0;
+};
+
+#endif
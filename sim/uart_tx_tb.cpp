@@ -1,34 +1,88 @@
 #include <iostream>
-#include <verilated.h>
+#include <vector>
 #include "Vuart_tx.h"
+#include "tb_framework.h"
 
 // PARAMETERS FROM SPECIFICATIONS
 // 115,200 Baud @ 12.5 MHz = 108.5 clocks per bit [cite: 14, 63, 71]
 const int CLOCKS_PER_BIT = 108;
 
-// Helper to step the system clock
-void tick(Vuart_tx* top) {
-    top->systemClock = 0; top->eval();
-    top->systemClock = 1; top->eval();
-}
+// Runtime divisor range exercised below: 1 clock per bit (12.5 Mbaud)
+// down to 1302 clocks per bit (9600 baud).
+const int MIN_DIVISOR = 1;
+const int MAX_DIVISOR = 1302;
+
+typedef Testbench<Vuart_tx> UartBench;
 
 // --- HELPER: SAMPLER FUNCTION ---
 // Advances time by 'n' clocks and returns the majority logic level.
-int sample_line(Vuart_tx* top, int clocksToWait) {
+int sample_line(UartBench& tb, int clocksToWait) {
     int sum = 0;
     for(int i = 0; i < clocksToWait; i++) {
-        tick(top);
-        sum += top->serialDataOutput;
+        tb.tick();
+        sum += tb->serialDataOutput;
     }
     // Return majority logic level
     return (sum > (clocksToWait / 2)) ? 1 : 0;
 }
 
+// --- HELPER: DRAIN ---
+// Runs the clock until the transmitter and its holding register are empty.
+void wait_idle(UartBench& tb) {
+    while (tb->isTransmitActive || tb->isTransmitBufferFull) tb.tick();
+    tb.tick(2); // Cleanup -> Idle
+}
+
+// --- HELPER: BACK-TO-BACK FRAME CHECK ---
+// Programs 'divisor', queues two bytes while the first is still shifting,
+// and checks every clock of both frames against the ideal waveform.
+// The second start bit must follow the first stop bit with no idle gap.
+bool check_back_to_back(UartBench& tb, int divisor, uint8_t first, uint8_t second) {
+    tb->divisorWriteValid = 1;
+    tb->divisorWriteData  = divisor;
+    tb.tick();
+    tb->divisorWriteValid = 0;
+    if (tb->divisorValue != divisor) return false;
+
+    std::vector<int> line;
+    tb->transmitDataValid = 1;
+    tb->transmitByte      = first;
+    tb.tick(); line.push_back(tb->serialDataOutput);
+    tb->transmitByte      = second; // Lands in the holding register
+    tb.tick(); line.push_back(tb->serialDataOutput);
+    tb->transmitDataValid = 0;
+    if (!tb->isTransmitBufferFull) return false;
+
+    const int frameClocks = 10 * divisor;
+    while ((int)line.size() < 1 + 2 * frameClocks + 4) {
+        tb.tick();
+        line.push_back(tb->serialDataOutput);
+    }
+
+    // Expected levels: start(0), 8 data bits LSB first, stop(1), per byte
+    uint8_t bytes[2] = {first, second};
+    for (int k = 0; k < 2; k++) {
+        for (int bit = 0; bit < 10; bit++) {
+            int level = (bit == 0) ? 0 : (bit == 9) ? 1 : (bytes[k] >> (bit - 1)) & 1;
+            int begin = 1 + (10 * k + bit) * divisor;
+            for (int t = begin; t < begin + divisor; t++) {
+                if (line[t] != level) return false;
+            }
+        }
+    }
+    // Line returns to idle after the second stop bit
+    for (size_t t = 1 + 2 * frameClocks; t < line.size(); t++) {
+        if (line[t] != 1) return false;
+    }
+
+    wait_idle(tb);
+    return true;
+}
+
 int main(int argc, char** argv) {
-    Verilated::commandArgs(argc, argv);
-    Vuart_tx* uart = new Vuart_tx;
+    UartBench tb(argc, argv, "UART Transmitter");
+    Vuart_tx* uart = tb.dut();
 
-    std::cout << "[TEST] Starting UART Verification (Expanded Camel Case)...\n";
     std::cout << "[INFO] Configuration: " << CLOCKS_PER_BIT << " clocks per bit.\n";
 
     // ==========================================
@@ -36,20 +90,17 @@ int main(int argc, char** argv) {
     // ==========================================
     uart->transmitDataValid = 0; 
     uart->transmitByte      = 0x00;
+    uart->divisorWriteValid = 0;
+    uart->divisorWriteData  = 0;
     
     int idleErrors = 0;
     for(int i = 0; i < 100; i++) {
-        tick(uart);
+        tb.tick();
         if (uart->serialDataOutput == 0)   idleErrors++; 
         if (uart->isTransmitActive == 1)   idleErrors++; 
     }
 
-    if (idleErrors == 0) {
-        std::cout << "[PASS] Idle State: Line High, Active signal Low.\n";
-    } else {
-        std::cerr << "[FAIL] Idle State Violation detected.\n";
-        return 1;
-    }
+    tb.check(idleErrors == 0, "Idle State: Line High, Active signal Low.", "Idle State Violation detected.");
 
     // ==========================================
     // TEST 2: DATA INTEGRITY (Character 'A')
@@ -59,65 +110,72 @@ int main(int argc, char** argv) {
 
     uart->transmitDataValid = 1;     
     uart->transmitByte      = testChar;
-    tick(uart);             
+    tb.tick();             
     uart->transmitDataValid = 0;     
 
     // --- CHECK 1: START BIT ---
-    if (sample_line(uart, CLOCKS_PER_BIT) == 0) {
-        std::cout << "[PASS] Start Bit Detected.\n";
-    } else {
-        std::cerr << "[FAIL] Start Bit Missing.\n"; return 1;
-    }
+    tb.check(sample_line(tb, CLOCKS_PER_BIT) == 0, "Start Bit Detected.", "Start Bit Missing.");
 
     // --- CHECK 2: DATA BITS (LSB -> MSB) ---
     // Expected for 0x41: 1, 0, 0, 0, 0, 0, 1, 0
     int expectedBits[8] = {1, 0, 0, 0, 0, 0, 1, 0};
+    int badBit = -1;
     for (int i = 0; i < 8; i++) {
-        if (sample_line(uart, CLOCKS_PER_BIT) == expectedBits[i]) {
-            // Bit matches
-        } else {
-            std::cerr << "[FAIL] Bit " << i << " Mismatch.\n";
-            return 1;
-        }
+        // Keep sampling after a mismatch so the stop bit check stays aligned
+        if (sample_line(tb, CLOCKS_PER_BIT) != expectedBits[i] && badBit < 0) badBit = i;
     }
-    std::cout << "[PASS] Data Payload Verified.\n";
+    tb.check(badBit < 0, "Data Payload Verified.", "Bit " + std::to_string(badBit) + " Mismatch.");
 
     // --- CHECK 3: STOP BIT ---
-    if (sample_line(uart, CLOCKS_PER_BIT) == 1) {
-        std::cout << "[PASS] Stop Bit Detected.\n";
-    } else {
-        std::cerr << "[FAIL] Stop Bit Missing.\n"; return 1;
-    }
+    tb.check(sample_line(tb, CLOCKS_PER_BIT) == 1, "Stop Bit Detected.", "Stop Bit Missing.");
 
     // --- CHECK 4: HANDSHAKE SIGNALS ---
-    tick(uart); // Transition to Cleanup/Idle
-    if (uart->isTransmitDone == 1 && uart->isTransmitActive == 0) {
-        std::cout << "[PASS] Handshake: Done asserted, Active cleared.\n";
-    } else {
-        std::cerr << "[FAIL] Handshake Signals failed logic check.\n";
-        return 1;
-    }
+    tb.tick(); // Transition to Cleanup/Idle
+    tb.check(uart->isTransmitDone == 1 && uart->isTransmitActive == 0,
+             "Handshake: Done asserted, Active cleared.", "Handshake Signals failed logic check.");
 
     // ==========================================
     // TEST 3: BACK-TO-BACK STRESS TEST
     // ==========================================
     uart->transmitDataValid = 1;
     uart->transmitByte      = 0x55; 
-    tick(uart);
+    tb.tick();
     uart->transmitDataValid = 0;
 
-    for(int i = 0; i < 10; i++) tick(uart);
+    tb.tick(10);
 
-    if (uart->isTransmitActive == 1 && uart->serialDataOutput == 0) {
-        std::cout << "[PASS] Stress Test: Back-to-Back restart successful.\n";
-    } else {
-        std::cerr << "[FAIL] Stress Test: UART failed to restart.\n";
-        return 1;
-    }
+    tb.check(uart->isTransmitActive == 1 && uart->serialDataOutput == 0,
+             "Stress Test: Back-to-Back restart successful.", "Stress Test: UART failed to restart.");
 
-    std::cout << "------------------------------------------\n";
-    std::cout << "[SUCCESS] UART Transmitter Verification Complete.\n";
+    // ==========================================
+    // TEST 4: RUNTIME DIVISOR SWEEP (BACK-TO-BACK)
+    // ==========================================
+    wait_idle(tb);
+    std::cout << "[TEST] Sweeping divisors " << MIN_DIVISOR << ".." << MAX_DIVISOR
+              << " with back-to-back frames...\n";
+
+    tb.vectors("All divisors produce gap-free back-to-back frames", MAX_DIVISOR - MIN_DIVISOR + 1, [&](uint64_t i) {
+        int divisor    = MIN_DIVISOR + (int)i;
+        uint8_t first  = (uint8_t)(divisor * 37 + 0x5A);
+        uint8_t second = (uint8_t)~first;
+        if (check_back_to_back(tb, divisor, first, second)) return true;
+        std::cout << "  Divisor " << divisor << ": frame timing or payload mismatch.\n";
+        return false;
+    });
 
-    delete uart;
-    return 0;
+    // ==========================================
+    // TEST 5: ZERO DIVISOR IS IGNORED
+    // ==========================================
+    // Programs its own starting divisor rather than relying on where Test 4 stopped
+    uart->divisorWriteValid = 1;
+    uart->divisorWriteData  = CLOCKS_PER_BIT;
+    tb.tick();
+    uart->divisorWriteData  = 0;
+    tb.tick();
+    uart->divisorWriteValid = 0;
+
+    tb.check(uart->divisorValue == CLOCKS_PER_BIT, "Divisor Guard: Write of 0 ignored.",
+             "Divisor changed to " + std::to_string(uart->divisorValue));
+
+    return tb.finish();
 }
\ No newline at end of file
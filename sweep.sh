@@ -0,0 +1,141 @@
+#!/bin/bash
+
+# Design-space sweep over soc_top parameters.
+# Builds one Verilator model per configuration (in parallel), runs the same
+# benchmark firmware on each (relinked per ROM_WORDS/RAM_WORDS/HARTS) and prints
+# cycles, context-switch overhead and simulation speed side by side.
+#
+# Usage: ./sweep.sh [config_file] [+plusargs...]
+#   config_file: one configuration per line, "<name> <-G overrides...>";
+#                '#' starts a comment. Without it the built-in set below runs.
+#   APP         firmware to run (default bench_pingpong), always CONSOLE=host
+#   JOBS        parallel builds/runs (default: all cores)
+#   SWEEP_DIR   output directory (default sweep_out): one model, log and
+#               trace per configuration
+# Extra arguments are passed to every run, e.g. +max-cycles=500000.
+
+chmod +x "$0" ./run.sh
+
+DEFAULT_CONFIGS="
+baseline
+timer_5k         -GTIMER_LIMIT=5000
+timer_20k        -GTIMER_LIMIT=20000
+uart_2x          -GUART_CLOCKS_PER_BIT=54
+sync_memory      -GMEMORY_SYNC_READ=1
+divider_1        -GCLOCK_DIVIDER_BITS=1
+"
+
+CONFIG_FILE=""
+if [ -n "$1" ] && [ "${1:0:1}" != "+" ]; then
+    CONFIG_FILE=$1
+    shift
+    if [ ! -f "$CONFIG_FILE" ]; then
+        echo "Error: sweep configuration not found: $CONFIG_FILE"
+        exit 1
+    fi
+fi
+
+APP="${APP:-bench_pingpong}"
+JOBS="${JOBS:-$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 4)}"
+SWEEP_DIR="${SWEEP_DIR:-sweep_out}"
+
+# Configurations as "name|flags", comments and blank lines dropped
+CONFIGS=()
+while read -r NAME FLAGS; do
+    [ -z "$NAME" ] || [ "${NAME:0:1}" == "#" ] && continue
+    CONFIGS+=("$NAME|$FLAGS")
+done < <(if [ -n "$CONFIG_FILE" ]; then cat "$CONFIG_FILE"; else echo "$DEFAULT_CONFIGS"; fi)
+
+if [ ${#CONFIGS[@]} -eq 0 ]; then
+    echo "Error: no configurations to sweep"
+    exit 1
+fi
+
+rm -rf "$SWEEP_DIR"
+mkdir -p "$SWEEP_DIR"
+
+# Waits until fewer than JOBS background jobs are running (bash 3 has no wait -n)
+throttle() {
+    while [ "$(jobs -rp | wc -l)" -ge "$JOBS" ]; do sleep 0.2; done
+}
+
+# Firmware image key for a configuration: link.ld is sized by ROM_WORDS,
+# RAM_WORDS and HARTS, so configurations that override them need their own build
+memory_key() {
+    local KEY=""
+    for FLAG in $VERILATOR_FLAGS $1; do
+        case "$FLAG" in
+            -GROM_WORDS=*|-GRAM_WORDS=*|-GHARTS=*) KEY="${KEY}_${FLAG#-G}" ;;
+        esac
+    done
+    echo "firmware${KEY:-_default}"
+}
+
+# ---------------------------------------------------------
+# 1. BUILD
+# ---------------------------------------------------------
+# The first configuration of each memory layout also builds the firmware (in
+# the foreground, as it shares firmware/) and keeps a copy in
+# $SWEEP_DIR/<memory key>; the rest reuse that image
+echo "--- BUILDING ${#CONFIGS[@]} CONFIGURATIONS ($APP, $JOBS jobs) ---"
+for INDEX in "${!CONFIGS[@]}"; do
+    NAME=${CONFIGS[$INDEX]%%|*}
+    FLAGS=${CONFIGS[$INDEX]#*|}
+    KEY=$(memory_key "$FLAGS")
+    mkdir -p "$SWEEP_DIR/$NAME"
+    BUILD_ENV="APP=$APP CONSOLE=host BUILD_ONLY=1 OBJ_DIR=$SWEEP_DIR/$NAME/obj_dir"
+    if [ ! -d "$SWEEP_DIR/$KEY" ]; then
+        env $BUILD_ENV VERILATOR_FLAGS="$VERILATOR_FLAGS $FLAGS" ./run.sh soc_top > "$SWEEP_DIR/$NAME/build.log" 2>&1 \
+            || { echo "Build failed: $NAME (see $SWEEP_DIR/$NAME/build.log)"; exit 1; }
+        cp -R firmware "$SWEEP_DIR/$KEY"
+    else
+        throttle
+        env $BUILD_ENV NO_FIRMWARE=1 VERILATOR_FLAGS="$VERILATOR_FLAGS $FLAGS" ./run.sh soc_top \
+            > "$SWEEP_DIR/$NAME/build.log" 2>&1 &
+    fi
+done
+wait
+
+# ---------------------------------------------------------
+# 2. RUN
+# ---------------------------------------------------------
+# Each model runs in its own directory (the firmware image for its memory
+# size linked in as firmware/) so the kernel trace and any other outputs do
+# not collide
+echo "--- RUNNING ---"
+for ENTRY in "${CONFIGS[@]}"; do
+    NAME=${ENTRY%%|*}
+    FLAGS=${ENTRY#*|}
+    if [ ! -x "$SWEEP_DIR/$NAME/obj_dir/Vsoc_top" ]; then
+        echo "Build failed: $NAME (see $SWEEP_DIR/$NAME/build.log)"
+        continue
+    fi
+    ln -sfn "../$(memory_key "$FLAGS")" "$SWEEP_DIR/$NAME/firmware"
+    throttle
+    (cd "$SWEEP_DIR/$NAME" && ./obj_dir/Vsoc_top +notrace "$@" > run.log 2>&1) &
+done
+wait
+
+# ---------------------------------------------------------
+# 3. REPORT
+# ---------------------------------------------------------
+# Columns come from the harness's [PERF] line; speed is CPU cycles per
+# wall-clock second and is only comparable between runs sharing the machine
+# equally (JOBS <= cores)
+echo "---------------------------------------------------------------------------------------------"
+printf "%-18s %12s %12s %14s %10s %12s %6s  %s\n" \
+       "config" "cycles" "preemptions" "switch-cycles" "overhead" "speed" "exit" "flags"
+for ENTRY in "${CONFIGS[@]}"; do
+    NAME=${ENTRY%%|*}
+    FLAGS=${ENTRY#*|}
+    PERF=$(grep -h "^\[PERF\]" "$SWEEP_DIR/$NAME/run.log" 2>/dev/null | tail -n 1)
+    if [ -z "$PERF" ]; then
+        printf "%-18s %12s %12s %14s %10s %12s %6s  %s\n" "$NAME" "-" "-" "-" "-" "-" "fail" "$FLAGS"
+        continue
+    fi
+    field() { echo "$PERF" | tr ' ' '\n' | awk -F= -v key="$1" '$1 == key { print $2 }'; }
+    printf "%-18s %12s %12s %14s %10s %12s %6s  %s\n" "$NAME" "$(field cycles)" "$(field preemptions)" \
+           "$(field switch-cycles)" "$(field overhead)" "$(field speed)" "$(field exit)" "$FLAGS"
+done
+echo "---------------------------------------------------------------------------------------------"
+echo "Logs: $SWEEP_DIR/<config>/run.log"